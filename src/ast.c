@@ -28,14 +28,15 @@ THE SOFTWARE.
 #include "vm.h"
 #include "libmem.h"
 
-#define dbc(I, A, B, C) bcode[i++] = lat_bc(I, A, B, C)
-#define pn(mv, N) i = nodo_analizar(mv, N, bcode, i)
-#define fdbc(I, A, B, C) funcion_bcode[fi++] = lat_bc(I, A, B, C)
-#define fpn(mv, N) fi = nodo_analizar(mv, N, funcion_bcode, fi)
+#define dbc(I, A) fun->bcode[i++] = lat_bc(I, A)
+#define pn(mv, N) i = nodo_analizar(mv, comp, N, fun, i)
+#define fdbc(I, A) funcion->bcode[fi++] = lat_bc(I, A)
+#define fpn(mv, N) fi = nodo_analizar(mv, comp, N, funcion, fi)
+#define constante(O) nodo_constante(comp, fun, O)
 
-ast *nodo_nuevo(nodo_tipo nt, ast *l, ast *r)
+ast *nodo_nuevo(lat_arena *arena, nodo_tipo nt, ast *l, ast *r)
 {
-    ast *a = (ast*)lat_asignar_memoria(sizeof(ast));
+    ast *a = (ast*)lat_arena_asignar(arena, sizeof(ast));
     a->tipo = nt;
     a->l = l;
     a->r = r;
@@ -43,51 +44,48 @@ ast *nodo_nuevo(nodo_tipo nt, ast *l, ast *r)
     return a;
 }
 
-ast *nodo_nuevo_entero(long i, int num_linea, int num_columna)
+/* nodo hoja con su valor; ambos se asignan juntos en la arena */
+static ast *nodo_nuevo_valor(lat_arena *arena, nodo_tipo nt, int num_linea, int num_columna)
 {
-    ast *a = (ast*)lat_asignar_memoria(sizeof(ast));
-    a->tipo = NODO_ENTERO;
-    nodo_valor *val = (nodo_valor*)lat_asignar_memoria(sizeof(nodo_valor));
-    val->t = VALOR_ENTERO;
-    val->v.i = i;
-    a->valor = val;
+    ast *a = (ast*)lat_arena_asignar(arena, sizeof(ast) + sizeof(nodo_valor));
+    a->tipo = nt;
+    a->l = NULL;
+    a->r = NULL;
+    a->valor = (nodo_valor*)(a + 1);
     a->valor->es_constante = false;
     a->valor->num_linea = num_linea;
     a->valor->num_columna = num_columna;
     return a;
 }
 
-ast *nodo_nuevo_cadena(const char *s, int num_linea, int num_columna)
+ast *nodo_nuevo_entero(lat_arena *arena, long i, int num_linea, int num_columna)
 {
-    ast *a = (ast*)lat_asignar_memoria(sizeof(ast));
-    a->tipo = NODO_CADENA;
-    nodo_valor *val = (nodo_valor*)lat_asignar_memoria(sizeof(nodo_valor));
-    val->t = VALOR_CADENA;
-    val->v.s = parse_string(s, strlen(s));
-    a->valor = val;
-    a->valor->es_constante = false;
-    a->valor->num_linea = num_linea;
-    a->valor->num_columna = num_columna;
+    ast *a = nodo_nuevo_valor(arena, NODO_ENTERO, num_linea, num_columna);
+    a->valor->t = VALOR_ENTERO;
+    a->valor->v.i = i;
     return a;
 }
 
-ast *nodo_nuevo_identificador(const char *s, int num_linea, int num_columna)
+ast *nodo_nuevo_cadena(lat_arena *arena, const char *s, int num_linea, int num_columna)
 {
-    ast *a = (ast*)lat_asignar_memoria(sizeof(ast));
-    a->tipo = NODO_IDENTIFICADOR;
-    nodo_valor *val = (nodo_valor*)lat_asignar_memoria(sizeof(nodo_valor));
-    val->t = VALOR_CADENA;
-    val->v.s = strdup0(s);
-    a->valor = val;
-    a->valor->es_constante = false;
-    a->valor->num_linea = num_linea;
-    a->valor->num_columna = num_columna;
+    ast *a = nodo_nuevo_valor(arena, NODO_CADENA, num_linea, num_columna);
+    size_t len = strlen(s);
+    a->valor->t = VALOR_CADENA;
+    a->valor->v.s = parse_string((char*)lat_arena_asignar(arena, len + 1), s, len);
+    return a;
+}
+
+ast *nodo_nuevo_identificador(lat_arena *arena, const char *s, int num_linea, int num_columna)
+{
+    ast *a = nodo_nuevo_valor(arena, NODO_IDENTIFICADOR, num_linea, num_columna);
+    a->valor->t = VALOR_CADENA;
+    a->valor->v.s = lat_arena_copiar(arena, s, strlen(s));
     return a;
 }
 
-ast *nodo_nuevo_asignacion(ast *v, ast *s)
+ast *nodo_nuevo_asignacion(lat_arena *arena, ast *v, ast *s)
 {
-    ast *a = (ast*)lat_asignar_memoria(sizeof(ast));
+    ast *a = (ast*)lat_arena_asignar(arena, sizeof(ast));
     a->tipo = NODO_ASIGNACION;
     a->l = v;
     a->r = s;
@@ -95,9 +93,9 @@ ast *nodo_nuevo_asignacion(ast *v, ast *s)
     return a;
 }
 
-ast *nodo_nuevo_si(ast *cond, ast *th, ast *el)
+ast *nodo_nuevo_si(lat_arena *arena, ast *cond, ast *th, ast *el)
 {
-    nodo_si *a = (nodo_si*)lat_asignar_memoria(sizeof(nodo_si));
+    nodo_si *a = (nodo_si*)lat_arena_asignar(arena, sizeof(nodo_si));
     a->tipo = NODO_SI;
     a->condicion = cond;
     a->entonces = th;
@@ -105,45 +103,381 @@ ast *nodo_nuevo_si(ast *cond, ast *th, ast *el)
     return (ast *)a;
 }
 
-void nodo_liberar(ast *a)
+ast *nodo_nuevo_funcion(lat_arena *arena, ast *nombre, ast *parametros, ast *sentencias)
+{
+    nodo_funcion *a = (nodo_funcion*)lat_arena_asignar(arena, sizeof(nodo_funcion));
+    a->tipo = NODO_FUNCION_USUARIO;
+    a->nombre = nombre;
+    a->parametros = parametros;
+    a->sentencias = sentencias;
+    return (ast *)a;
+}
+
+/* tabla de simbolos de una funcion: nombres de los parametros y variables
+   locales, el indice es el numero de variable que usan LOAD_FAST /
+   STORE_FAST. Las variables que usa una funcion anidada se guardan por
+   nombre en el contexto local, donde la anidada las encuentra a traves de
+   su alcance (LOAD_NAME) */
+typedef struct nodo_simbolos
+{
+    char *locales[MAX_VARIABLES_LOCALES];
+    bool capturados[MAX_VARIABLES_LOCALES];    /* la variable la usa una funcion anidada */
+    int num_locales;
+    /* la funcion tiene mas variables de las que caben en la tabla: las que no
+       caben se asignan por nombre en su contexto local */
+    bool desbordados;
+    struct nodo_simbolos *padre;    /* tabla de la funcion que encierra a esta, NULL en el programa principal */
+} nodo_simbolos;
+
+/* estado de una compilacion; cada arbol se compila con el suyo, por lo que
+   varias MV pueden compilar a la vez en distintos hilos */
+struct nodo_compilador
+{
+    /* tabla de la funcion que se esta generando; fuera de una funcion no hay
+       variables locales */
+    nodo_simbolos *simbolos;
+    int num_args;       /* argumentos de la llamada que se esta generando */
+    /* primer registro libre: una subexpresion que se genera con
+       instrucciones de pila dentro de una expresion de registros no debe
+       usar los registros que ya tienen operandos */
+    int registro_libre;
+    /* hubo un error al generar el codigo: se deja de generar y el programa
+       no se ejecuta */
+    bool error;
+};
+
+/* indice de o en la tabla de constantes de fun; si la tabla esta llena se
+   detiene la compilacion y se regresa 0 para no codificar un indice
+   invalido en la instruccion */
+static int nodo_constante(nodo_compilador *comp, lat_funcion *fun, lat_objeto *o)
+{
+    int k = lat_agregar_constante(fun, o);
+    if (k < 0)
+    {
+        comp->error = true;
+        return 0;
+    }
+    return k;
+}
+
+lat_objeto *nodo_analizar_arbol(lat_mv *mv, lat_arena *arena, ast *tree)
+{
+    lat_funcion *fun = lat_crear_funcion(0);
+    nodo_compilador compilador;
+    int i;
+    compilador.simbolos = NULL;
+    compilador.num_args = 0;
+    compilador.registro_libre = 0;
+    compilador.error = false;
+    i = nodo_analizar(mv, &compilador, tree, fun, 0);
+    lat_arena_liberar(arena);
+    if (compilador.error)
+    {
+        lat_liberar_memoria(fun->bcode);
+        lat_liberar_memoria(fun->constantes);
+        lat_liberar_memoria(fun);
+        return NULL;
+    }
+    dbc(RETURN_VALUE, 0);
+    lat_terminar_funcion(fun, i);
+    return lat_definir_funcion(mv, fun);
+}
+
+/* instruccion de la MV que corresponde a un nodo operador binario */
+static lat_ins nodo_operador(nodo_tipo tipo)
+{
+    switch (tipo)
+    {
+    case NODO_DESIGUALDAD:
+        return COMPARE_OP_NEQ;
+    case NODO_MENOR_QUE:
+        return COMPARE_OP_LT;
+    case NODO_MENOR_IGUAL:
+        return COMPARE_OP_LTE;
+    case NODO_MAYOR_QUE:
+        return COMPARE_OP_GT;
+    case NODO_MAYOR_IGUAL:
+        return COMPARE_OP_GTE;
+    case NODO_SUMA:
+        return BINARY_ADD;
+    case NODO_RESTA:
+        return BINARY_SUBTRACT;
+    case NODO_MULTIPLICACION:
+        return BINARY_MULTIPLY;
+    case NODO_DIVISION:
+        return BINARY_FLOOR_DIVIDE;
+    case NODO_MODULO:
+        return BINARY_MODULO;
+    default:
+        return COMPARE_OP_EQ;
+    }
+}
+
+/* las tablas se reservan en el heap: nodo_analizar es recursivo en cada
+   sentencia y no debe cargar la tabla en cada marco */
+static nodo_simbolos *nodo_crear_simbolos(nodo_simbolos *padre)
+{
+    nodo_simbolos *tabla = (nodo_simbolos *)lat_asignar_memoria(sizeof(nodo_simbolos));
+    tabla->num_locales = 0;
+    tabla->desbordados = false;
+    tabla->padre = padre;
+    return tabla;
+}
+
+static int nodo_posicion_simbolo(nodo_simbolos *tabla, const char *nombre)
+{
+    int p;
+    for (p = 0; p < tabla->num_locales; p++)
+    {
+        if (strcmp(tabla->locales[p], nombre) == 0)
+        {
+            return p;
+        }
+    }
+    return -1;
+}
+
+/* numero de variable (LOAD_FAST / STORE_FAST) del nombre en la funcion que
+   se esta generando, -1 si no es local o se guarda por nombre */
+static int nodo_buscar_local(nodo_compilador *comp, const char *nombre)
 {
-    if (a)
+    int p;
+    if (comp->simbolos == NULL)
+    {
+        return -1;
+    }
+    p = nodo_posicion_simbolo(comp->simbolos, nombre);
+    return p >= 0 && !comp->simbolos->capturados[p] ? p : -1;
+}
+
+/* un nombre que no tiene numero de variable se lee por nombre (LOAD_NAME)
+   si es una variable capturada de la funcion, si es local de una funcion
+   que la encierra o si alguna de esas tablas se desbordo; si no, es una
+   variable global (LOAD_GLOBAL) */
+static bool nodo_buscar_por_nombre(nodo_compilador *comp, const char *nombre)
+{
+    nodo_simbolos *tabla;
+    for (tabla = comp->simbolos; tabla != NULL; tabla = tabla->padre)
+    {
+        if (tabla->desbordados || nodo_posicion_simbolo(tabla, nombre) >= 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void nodo_agregar_local(nodo_simbolos *tabla, char *nombre)
+{
+    //si se llena la tabla la variable se guarda por nombre
+    if (nodo_posicion_simbolo(tabla, nombre) < 0)
+    {
+        if (tabla->num_locales < MAX_VARIABLES_LOCALES)
+        {
+            tabla->capturados[tabla->num_locales] = false;
+            tabla->locales[tabla->num_locales++] = nombre;
+        }
+        else
+        {
+            tabla->desbordados = true;
+        }
+    }
+}
+
+/* los parametros ocupan las primeras variables, la lista guarda el ultimo
+   parametro a la izquierda; regresa falso si no caben en la tabla */
+static bool nodo_declarar_parametros(ast *node, nodo_simbolos *tabla)
+{
+    if (node == NULL)
+    {
+        return true;
+    }
+    if (node->r && !nodo_declarar_parametros(node->r, tabla))
+    {
+        return false;
+    }
+    if (node->l && node->l->valor)
+    {
+        if (tabla->num_locales >= MAX_VARIABLES_LOCALES)
+        {
+            return false;
+        }
+        tabla->capturados[tabla->num_locales] = false;
+        tabla->locales[tabla->num_locales++] = node->l->valor->v.s;
+    }
+    return true;
+}
+
+/* analisis de alcance: toda variable que se asigna (o funcion que se define)
+   dentro de la funcion es local; las funciones anidadas tienen sus propias
+   variables, por eso no se recorren */
+static void nodo_declarar_locales(ast *node, nodo_simbolos *tabla)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+    switch (node->tipo)
+    {
+    case NODO_BLOQUE:
+        nodo_declarar_locales(node->r, tabla);
+        nodo_declarar_locales(node->l, tabla);
+        return;
+    case NODO_SI:
+        nodo_declarar_locales(((nodo_si *)node)->entonces, tabla);
+        nodo_declarar_locales(((nodo_si *)node)->sino, tabla);
+        return;
+    case NODO_ASIGNACION:
+        nodo_agregar_local(tabla, node->r->valor->v.s);
+        return;
+    case NODO_FUNCION_USUARIO:
+        nodo_agregar_local(tabla, ((nodo_funcion *)node)->nombre->valor->v.s);
+        return;
+    default:
+        return;
+    }
+}
+
+/* marca las variables de la funcion f que usan las funciones anidadas en
+   node; actual es la tabla de la funcion donde esta node. Un nombre que no
+   es local de la anidada ni de las que estan entre ella y f es de f */
+static void nodo_buscar_capturas(ast *node, nodo_simbolos *f, nodo_simbolos *actual)
+{
+    if (node == NULL)
+    {
+        return;
+    }
+    switch (node->tipo)
+    {
+    case NODO_IDENTIFICADOR:
     {
-        switch (a->tipo)
+        nodo_simbolos *tabla;
+        int p;
+        for (tabla = actual; tabla != f; tabla = tabla->padre)
+        {
+            if (nodo_posicion_simbolo(tabla, node->valor->v.s) >= 0)
+            {
+                return;
+            }
+        }
+        p = nodo_posicion_simbolo(f, node->valor->v.s);
+        if (actual != f && p >= 0)
         {
-        case NODO_BLOQUE:
-            if (a->r)
-                nodo_liberar(a->r);
-            if (a->l)
-                nodo_liberar(a->l);
-            break;
-        default:
-            if (a->tipo)
-                lat_liberar_memoria(a->valor);
-            lat_liberar_memoria(a);
-            break;
+            f->capturados[p] = true;
         }
+        return;
+    }
+    case NODO_SI:
+        nodo_buscar_capturas(((nodo_si *)node)->condicion, f, actual);
+        nodo_buscar_capturas(((nodo_si *)node)->entonces, f, actual);
+        nodo_buscar_capturas(((nodo_si *)node)->sino, f, actual);
+        return;
+    case NODO_FUNCION_USUARIO:
+    {
+        nodo_funcion *nFun = (nodo_funcion *)node;
+        nodo_simbolos *anidada = nodo_crear_simbolos(actual);
+        nodo_declarar_parametros(nFun->parametros, anidada);
+        nodo_declarar_locales(nFun->sentencias, anidada);
+        nodo_buscar_capturas(nFun->sentencias, f, anidada);
+        lat_liberar_memoria(anidada);
+        return;
+    }
+    default:
+        nodo_buscar_capturas(node->l, f, actual);
+        nodo_buscar_capturas(node->r, f, actual);
+        return;
     }
 }
 
-lat_objeto *nodo_analizar_arbol(lat_mv *mv, ast *tree)
+/* funcion predefinida a la que llama node (ver lat_buscar_nativa) o -1 si
+   el nombre es una variable local o la llamada es dinamica */
+static int nodo_nativa(nodo_compilador *comp, ast *node)
 {
-    lat_bytecode *bcode = (lat_bytecode *)lat_asignar_memoria(sizeof(lat_bytecode) * MAX_BYTECODE_FUNCTION);
-    int i = nodo_analizar(mv, tree, bcode, 0);
-    dbc(RETURN_VALUE, NULL, NULL, NULL);
-    nodo_liberar(tree);
-    return lat_definir_funcion(mv, bcode, 0);
+    if (node->l->tipo != NODO_IDENTIFICADOR || nodo_buscar_local(comp, node->l->valor->v.s) >= 0 || nodo_buscar_por_nombre(comp, node->l->valor->v.s))
+    {
+        return -1;
+    }
+    return lat_buscar_nativa(node->l->valor->v.s);
+}
+
+/* constante entera de la funcion: los enteros pequenos van etiquetados y el
+   resto queda inmortal, como el resto de la tabla de constantes */
+static lat_objeto* nodo_constante_entera(lat_mv *mv, long valor)
+{
+    lat_objeto* ret = lat_entero_nuevo(mv, valor);
+    if (!lat_es_etiquetado(ret))
+    {
+        ret->inmortal = true;
+    }
+    return ret;
 }
 
-int nested = -1;
-int num_params = 0;
-int num_args = 0;
+static bool nodo_es_operador(nodo_tipo tipo)
+{
+    return tipo == NODO_IGUALDAD || (tipo >= NODO_DESIGUALDAD && tipo <= NODO_MODULO);
+}
+
+/* genera el valor de node como operando de una instruccion de registros: las
+   constantes con indice pequeno se usan directamente (RK), los nombres y
+   operadores se calculan en el registro r y el resto se genera con
+   instrucciones de pila y se saca al registro r */
+static int nodo_analizar_registro(lat_mv *mv, nodo_compilador *comp, ast *node, lat_funcion *fun, int i, int r, int *operando)
+{
+    int k;
+    *operando = r;
+    if (node->tipo == NODO_ENTERO || node->tipo == NODO_CADENA)
+    {
+        lat_objeto *ret = node->tipo == NODO_ENTERO ? nodo_constante_entera(mv, node->valor->v.i) : lat_cadena_nueva(mv, node->valor->v.s);
+        k = constante(ret);
+        if (k < LAT_RK_CONSTANTE)
+        {
+            *operando = k | LAT_RK_CONSTANTE;
+        }
+        else if (k <= LAT_BX_MAX)
+        {
+            dbc(LOAD_CONST_R, LAT_ABX(r, k));
+        }
+        else
+        {
+            dbc(LOAD_CONST, k);
+            dbc(POP_R, r);
+        }
+    }
+    else if (node->tipo == NODO_IDENTIFICADOR && (k = nodo_buscar_local(comp, node->valor->v.s)) >= 0)
+    {
+        dbc(LOAD_FAST_R, LAT_ABX(r, k));
+    }
+    else if (node->tipo == NODO_IDENTIFICADOR && (k = constante(lat_cadena_nueva(mv, node->valor->v.s))) <= LAT_BX_MAX)
+    {
+        dbc(nodo_buscar_por_nombre(comp, node->valor->v.s) ? LOAD_NAME_R : LOAD_GLOBAL_R, LAT_ABX(r, k));
+    }
+    else if (nodo_es_operador(node->tipo) && r + 1 < LAT_NUM_REGISTROS)
+    {
+        int b, c;
+        i = nodo_analizar_registro(mv, comp, node->l, fun, i, r, &b);
+        i = nodo_analizar_registro(mv, comp, node->r, fun, i, r + 1, &c);
+        dbc(BINARY_ADD_R + (nodo_operador(node->tipo) - BINARY_ADD), LAT_ABC(r, b, c));
+    }
+    else
+    {
+        int libre = comp->registro_libre;
+        comp->registro_libre = r;
+        pn(mv, node);
+        comp->registro_libre = libre;
+        dbc(POP_R, r);
+    }
+    return i;
+}
 
-int nodo_analizar(lat_mv *mv, ast *node, lat_bytecode *bcode, int i)
+int nodo_analizar(lat_mv *mv, nodo_compilador *comp, ast *node, lat_funcion *fun, int i)
 {
     int temp[8] = {0};
-    lat_bytecode *funcion_bcode = NULL;
+    lat_funcion *funcion = NULL;
     int fi = 0;
+    if (comp->error)
+    {
+        return i;
+    }
     switch (node->tipo)
     {
     case NODO_BLOQUE:
@@ -160,27 +494,45 @@ int nodo_analizar(lat_mv *mv, ast *node, lat_bytecode *bcode, int i)
     break;
     case NODO_IDENTIFICADOR: /*GET*/
     {
-        lat_objeto *ret = lat_cadena_nueva(mv, node->valor->v.s);
-        dbc(LOAD_NAME, ret, NULL, NULL);
+        int p = nodo_buscar_local(comp, node->valor->v.s);
+        if (p >= 0)
+        {
+            dbc(LOAD_FAST, p);
+        }
+        else
+        {
+            //fuera de una funcion (o si no esta en ninguna tabla de simbolos) es global
+            lat_objeto *ret = lat_cadena_nueva(mv, node->valor->v.s);
+            dbc(nodo_buscar_por_nombre(comp, node->valor->v.s) ? LOAD_NAME : LOAD_GLOBAL, constante(ret));
+        }
     }
     break;
     case NODO_ASIGNACION: /*SET*/
     {
+        int p = nodo_buscar_local(comp, node->r->valor->v.s);
         pn(mv, node->l);
-        lat_objeto *ret = lat_cadena_nueva(mv, node->r->valor->v.s);
-        dbc(STORE_NAME, ret, NULL, NULL);
+        if (p >= 0)
+        {
+            dbc(STORE_FAST, p);
+        }
+        else
+        {
+            //dentro de una funcion se asigna por nombre en el contexto local
+            lat_objeto *ret = lat_cadena_nueva(mv, node->r->valor->v.s);
+            dbc(comp->simbolos != NULL ? STORE_NAME : STORE_GLOBAL, constante(ret));
+        }
     }
     break;
     case NODO_ENTERO:
     {
-        lat_objeto *ret = lat_entero_nuevo(mv, node->valor->v.i);
-        dbc(LOAD_CONST, ret, NULL, NULL);
+        lat_objeto *ret = nodo_constante_entera(mv, node->valor->v.i);
+        dbc(LOAD_CONST, constante(ret));
     }
     break;
     case NODO_CADENA:
     {
         lat_objeto *ret = lat_cadena_nueva(mv, node->valor->v.s);
-        dbc(LOAD_CONST, ret, NULL, NULL);
+        dbc(LOAD_CONST, constante(ret));
     }
     break;
     case NODO_SI:
@@ -210,76 +562,117 @@ fin
         nodo_si *nSi = ((nodo_si *)node);
         pn(mv, nSi->condicion);
         temp[0] = i;
-        dbc(NOP, NULL, NULL, NULL); //instruccion auxiliar para suplantar por POP_JUMP_IF_FALSE
+        dbc(NOP, 0); //instruccion auxiliar para suplantar por POP_JUMP_IF_FALSE
         pn(mv, nSi->entonces);
         if (nSi->sino == NULL)
         {
             //no hay instruccion SINO
-            bcode[temp[0]] = lat_bc(POP_JUMP_IF_FALSE, (void*)i, NULL, NULL);
+            fun->bcode[temp[0]] = lat_bc(POP_JUMP_IF_FALSE, i);
         }else{
             temp[1] = i;
-            dbc(NOP, NULL, NULL, NULL); //instruccion auxiliar para suplantar por JUMP_FORWARD
+            dbc(NOP, 0); //instruccion auxiliar para suplantar por JUMP_FORWARD
             pn(mv, nSi->sino);
-            bcode[temp[0]] = lat_bc(POP_JUMP_IF_FALSE, (void*)(temp[1]+1), NULL, NULL);
-            bcode[temp[1]] = lat_bc(JUMP_FORWARD, (void*)i, NULL, NULL);
+            fun->bcode[temp[0]] = lat_bc(POP_JUMP_IF_FALSE, temp[1]+1);
+            fun->bcode[temp[1]] = lat_bc(JUMP_FORWARD, i);
         }
     }
     break;
     case NODO_FUNCION_USUARIO:
     {
         nodo_funcion *nFun = ((nodo_funcion *)node);
-        funcion_bcode =
-            (lat_bytecode *)lat_asignar_memoria(sizeof(lat_bytecode) * MAX_BYTECODE_FUNCTION);
+        nodo_simbolos *tabla = nodo_crear_simbolos(comp->simbolos);
+        nodo_simbolos *externos = comp->simbolos;
+        int p = nodo_buscar_local(comp, nFun->nombre->valor->v.s);
+        int parametros;
+        int k;
+        funcion = lat_crear_funcion(0);
         fi = 0;
-        num_params = 0;
-        //parametros de la funcion
-        if (nFun->parametros)
+        //parametros de la funcion, los argumentos llegan en la pila
+        if (!nodo_declarar_parametros(nFun->parametros, tabla))
+        {
+            lat_registrar_error("Demasiados parametros en la funcion");
+            comp->error = true;
+        }
+        parametros = tabla->num_locales;
+        nodo_declarar_locales(nFun->sentencias, tabla);
+        nodo_buscar_capturas(nFun->sentencias, tabla, tabla);
+        comp->simbolos = tabla;
+        //los parametros que usan las funciones anidadas pasan al contexto local
+        for (k = 0; k < parametros; k++)
         {
-            fpn(mv, nFun->parametros);
+            if (tabla->capturados[k])
+            {
+                fdbc(LOAD_FAST, k);
+                fdbc(STORE_NAME, nodo_constante(comp, funcion, lat_cadena_nueva(mv, tabla->locales[k])));
+            }
         }
         fpn(mv, nFun->sentencias);
-        dbc(MAKE_FUNCTION, (void*)funcion_bcode, (void*)num_params, NULL);
-        lat_objeto *ret = lat_cadena_nueva(mv, nFun->nombre->valor->v.s);
-        dbc(STORE_NAME, ret, NULL, NULL);
-        funcion_bcode = NULL;
+        //una funcion sin retorno regresa nulo
+        fdbc(LOAD_CONST, nodo_constante(comp, funcion, mv->objeto_nulo));
+        fdbc(RETURN_VALUE, 0);
+        funcion->num_params = parametros;
+        funcion->num_locales = tabla->num_locales - parametros;
+        lat_terminar_funcion(funcion, fi);
+        comp->simbolos = externos;
+        lat_liberar_memoria(tabla);
+        dbc(MAKE_FUNCTION, constante(lat_definir_funcion(mv, funcion)));
+        if (p >= 0)
+        {
+            dbc(STORE_FAST, p);
+        }
+        else
+        {
+            lat_objeto *ret = lat_cadena_nueva(mv, nFun->nombre->valor->v.s);
+            dbc(comp->simbolos != NULL ? STORE_NAME : STORE_GLOBAL, constante(ret));
+        }
+        funcion = NULL;
         fi = 0;
-        num_params = 0;
     }
     break;
-    case NODO_LISTA_PARAMETROS:
+    case NODO_RETORNO:
     {
-        lat_objeto* ret = NULL;
-        if (node->l)
+        if (node->l->tipo == NODO_FUNCION_LLAMADA && nodo_nativa(comp, node->l) < 0)
         {
-            if(node->l->valor){
-                ret = lat_clonar_objeto(mv, lat_cadena_nueva(mv, node->l->valor->v.s));
-                dbc(STORE_NAME, ret, NULL, NULL);
+            //llamada en posicion de retorno
+            comp->num_args = 0;
+            if (node->l->r)
+            {
+                pn(mv, node->l->r);
             }
-            //pn(mv, node->l);
-            num_params++;
+            pn(mv, node->l->l);
+            dbc(TAIL_CALL, comp->num_args);
+            comp->num_args = 0;
         }
-        if (node->r)
-            pn(mv, node->r);
-    }
-    break;
-    case NODO_RETORNO:
-    {
-        pn(mv, node->l);
-        dbc(RETURN_VALUE, NULL, NULL, NULL);
+        else
+        {
+            pn(mv, node->l);
+        }
+        dbc(RETURN_VALUE, 0);
     }
     break;
     case NODO_FUNCION_LLAMADA:
     {
+        int nativa = nodo_nativa(comp, node);
+        //una llamada anidada en los argumentos no debe perder la cuenta externa
+        int args_externos = comp->num_args;
         //procesa los argumentos
-        num_args = 0;
+        comp->num_args = 0;
         if (node->r)
         {
             pn(mv, node->r);
         }
-        //procesa el identificador de la funcion ej. escribir
-        pn(mv, node->l);
-        dbc(CALL_FUNCTION, (void*)num_args, NULL, NULL);
-        num_args = 0;
+        //las funciones predefinidas se llaman sin apilar la funcion
+        if (nativa >= 0 && comp->num_args <= 0xFF)
+        {
+            dbc(CALL_BUILTIN, LAT_ABC(nativa, comp->num_args, 0));
+        }
+        else
+        {
+            //procesa el identificador de la funcion ej. escribir
+            pn(mv, node->l);
+            dbc(CALL_FUNCTION, comp->num_args);
+        }
+        comp->num_args = args_externos;
     }
     break;
     case NODO_FUNCION_ARGUMENTOS:
@@ -287,17 +680,64 @@ fin
         if (node->l)
         {
             pn(mv, node->l);
-            num_args++;
+            comp->num_args++;
         }
         if (node->r)
         {
             pn(mv, node->r);
             if(node->r->valor)
-                num_args++;
+                comp->num_args++;
+        }
+    }
+    break;
+    case NODO_DICCIONARIO:
+    {
+        //los pares llave, valor quedan en la pila en el orden en que se escribieron
+        ast *elementos;
+        int n = 0;
+        for (elementos = node->l; elementos != NULL; elementos = elementos->r)
+        {
+            pn(mv, elementos->l->l);
+            pn(mv, elementos->l->r);
+            n++;
         }
+        dbc(BUILD_MAP, n);
+    }
+    break;
+    case NODO_INDICE:
+    {
+        pn(mv, node->l);
+        pn(mv, node->r);
+        dbc(BINARY_SUBSCR, 0);
+    }
+    break;
+    case NODO_ASIGNACION_INDICE:
+    {
+        //valor, diccionario y llave
+        pn(mv, node->l);
+        pn(mv, node->r->l);
+        pn(mv, node->r->r);
+        dbc(STORE_SUBSCR, 0);
     }
     break;
     case NODO_IGUALDAD:
+    case NODO_DESIGUALDAD:
+    case NODO_MENOR_QUE:
+    case NODO_MENOR_IGUAL:
+    case NODO_MAYOR_QUE:
+    case NODO_MAYOR_IGUAL:
+    case NODO_SUMA:
+    case NODO_RESTA:
+    case NODO_MULTIPLICACION:
+    case NODO_DIVISION:
+    case NODO_MODULO:
+        if (mv->modo_registros && comp->registro_libre + 1 < LAT_NUM_REGISTROS)
+        {
+            int r;
+            i = nodo_analizar_registro(mv, comp, node, fun, i, comp->registro_libre, &r);
+            dbc(PUSH_R, r);
+        }
+        else
         {
             if(node->l){
                 pn(mv, node->l);
@@ -305,12 +745,13 @@ fin
             if(node->r){
                 pn(mv, node->r);
             }
-            dbc(COMPARE_OP_EQ, NULL, NULL, NULL);
+            dbc(nodo_operador(node->tipo), 0);
         }
     break;
     default:
-        printf("nodo_tipo:%i\n", node->tipo);
-        return 0;
+        lat_registrar_error("Tipo de nodo no soportado por el analizador: %i", node->tipo);
+        comp->error = true;
+        return i;
     }
     return i;
 }
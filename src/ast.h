@@ -72,6 +72,21 @@ typedef enum {
   NODO_ASIGNACION,
   NODO_LISTA_PARAMETROS,
   NODO_FUNCION_LLAMADA,
+  NODO_DESIGUALDAD,  /**< Nodo desigualdad (!=) */
+  NODO_MENOR_QUE,  /**< Nodo menor que (<) */
+  NODO_MENOR_IGUAL,  /**< Nodo menor o igual (<=) */
+  NODO_MAYOR_QUE,  /**< Nodo mayor que (>) */
+  NODO_MAYOR_IGUAL,  /**< Nodo mayor o igual (>=) */
+  NODO_SUMA,  /**< Nodo suma (+) */
+  NODO_RESTA,  /**< Nodo resta (-) */
+  NODO_MULTIPLICACION,  /**< Nodo multiplicacion (*) */
+  NODO_DIVISION,  /**< Nodo division (/) */
+  NODO_MODULO,  /**< Nodo modulo (%) */
+  NODO_DICCIONARIO,  /**< Nodo diccionario ({llave: valor, ...}) */
+  NODO_DICCIONARIO_ELEMENTOS,  /**< Lista de pares llave: valor de un diccionario */
+  NODO_LLAVE_VALOR,  /**< Par llave: valor */
+  NODO_INDICE,  /**< Nodo indice (diccionario[llave]) */
+  NODO_ASIGNACION_INDICE,  /**< Nodo asignacion a un indice (diccionario[llave] = valor) */
 } nodo_tipo;
 
 /** \brief Nodos en arbol abstacto de sintaxis (Abstract Syntax Tree).
@@ -86,7 +101,11 @@ typedef struct ast {
 } ast;
 
 /** \brief Estado del analizador lexico */
-typedef struct lex_state { int insert; } lex_state;
+typedef struct lex_state {
+  int insert;
+  lat_arena *arena; /**< Memoria de los nodos y cadenas del arbol */
+  int operando; /**< El ultimo token fue un operando (identificador, numero, cadena o ')') */
+} lex_state;
 
 /** \brief Tipo de dato que se envia al analizador lexico */
 typedef union YYSTYPE {
@@ -124,92 +143,111 @@ typedef struct {
 
 /** \brief Nuevo nodo generico para el AST
   *
+  * \param arena: Arena del analisis
   * \param tipo: Tipo de nodo
   * \param l: Nodo izquierdo
   * \param r: Nodo derecho
   * \return ast: Un nodo AST
   *
   */
-ast *nodo_nuevo(nodo_tipo tipo, ast *l, ast *r);
+ast *nodo_nuevo(lat_arena *arena, nodo_tipo tipo, ast *l, ast *r);
 
 /** Nuevo nodo tipo Identificador (var)
   *
+  * \param arena: Arena del analisis
   * \param s: nombre del identificador
   * \return ast: Un nodo AST
   *
   */
-ast *nodo_nuevo_identificador(const char *s, int num_linea, int num_columna);
+ast *nodo_nuevo_identificador(lat_arena *arena, const char *s, int num_linea, int num_columna);
 
 /** Nuevo nodo tipo Entero (1234)
   *
+  * \param arena: Arena del analisis
   * \param i: Nodo valor
   * \return ast: Un nodo AST
   *
   */
-ast *nodo_nuevo_entero(long i, int num_linea, int num_columna);
+ast *nodo_nuevo_entero(lat_arena *arena, long i, int num_linea, int num_columna);
 
 /** Nuevo nodo tipo Cadena ("Esto es una 'cadena'")
   *
+  * \param arena: Arena del analisis
   * \param s: Nodo valor
   * \return ast: Un nodo AST
   *
   */
-ast *nodo_nuevo_cadena(const char *s, int num_linea, int num_columna);
+ast *nodo_nuevo_cadena(lat_arena *arena, const char *s, int num_linea, int num_columna);
 
 /** Nuevo nodo tipo Operador (var1 + var2)
   *
+  * \param arena: Arena del analisis
   * \param nt: tipo de nodo
   * \param l: Nodo izquierdo
   * \param r: Nodo derecho
   * \return ast: Un nodo AST
   *
   */
-ast *nodo_nuevo(nodo_tipo nt, ast *l, ast *r);
+ast *nodo_nuevo(lat_arena *arena, nodo_tipo nt, ast *l, ast *r);
 
 /** Nuevo nodo tipo Asignacion (var = "hola latino")
   *
+  * \param arena: Arena del analisis
   * \param s: Nodo identificador
   * \param v: Nodo valor
   * \return ast: Un nodo AST
   *
   */
-ast *nodo_nuevo_asignacion(ast *s, ast *v);
+ast *nodo_nuevo_asignacion(lat_arena *arena, ast *s, ast *v);
 
 /** Nuevo nodo tipo si (if)
   *
+  * \param arena: Arena del analisis
   * \param cond: Nodo condicion ( a > b && a > c )
   * \param th: Nodo lista de sentencias (en caso de ser verdadera la condicion)
   * \param el: Nodo lista de sentencias (en caso de ser falsa la condicion)
   * \return ast: Un nodo AST
   *
   */
-ast *nodo_nuevo_si(ast *cond, ast *th, ast *el);
+ast *nodo_nuevo_si(lat_arena *arena, ast *cond, ast *th, ast *el);
 
-/** Libera la memoria creada dinamicamente
+/** Nuevo nodo tipo funcion
   *
-  * \param a: Nodo AST
+  * \param arena: Arena del analisis
+  * \param nombre: Nodo identificador con el nombre de la funcion
+  * \param parametros: Nodo lista de parametros
+  * \param sentencias: Nodo lista de sentencias de la funcion
+  * \return ast: Un nodo AST
   *
   */
-void nodo_liberar(ast *a);
+ast *nodo_nuevo_funcion(lat_arena *arena, ast *nombre, ast *parametros, ast *sentencias);
 
-/** Analiza el arbol abstracto de sintaxis
+/** Analiza el arbol abstracto de sintaxis; al terminar de generar el
+  * bytecode libera la arena con el arbol y sus cadenas
   *
   * \param vm: Referencia a un objeto tipo maquina virtual
+  * \param arena: Arena donde se creo el arbol
   * \param tree: Arbol abstracto de sintaxis
-  * \return lat_object: objeto generico
+  * \return lat_object: La funcion del programa o NULL si hubo un error al
+  * generar el codigo
   *
   */
-lat_objeto *nodo_analizar_arbol(lat_mv *mv, ast *tree);
+lat_objeto *nodo_analizar_arbol(lat_mv *mv, lat_arena *arena, ast *tree);
+
+/** \brief Estado de una compilacion (tablas de simbolos, llamada y registros
+  * en curso, error); nodo_analizar_arbol crea uno por arbol */
+typedef struct nodo_compilador nodo_compilador;
 
 /** Analiza un nodo del arbol abstracto de sintaxis
   *
   * \param vm: Referencia a un objeto tipo maquina virtual
+  * \param comp: Estado de la compilacion
   * \param node: Nodo AST
-  * \param bcode: Referencia a un objeto tipo bytecode
+  * \param fun: Funcion a la que se agregan las instrucciones y constantes
   * \param i: numero de instruccion actual
   * \return int: numero de instruccion siguiente
   *
   */
-int nodo_analizar(lat_mv *mv, ast *node, lat_bytecode *bcode, int i);
+int nodo_analizar(lat_mv *mv, nodo_compilador *comp, ast *node, lat_funcion *fun, int i);
 
 #endif /*_AST_H_*/
@@ -33,17 +33,16 @@ THE SOFTWARE.
 int yydebug = 0;
 int analisis_silencioso;
 static FILE *file;
-static char *buffer;
 
 int yyparse(ast **root, yyscan_t scanner);
 
-ast *lat_analizar_expresion(lat_mv *mv, char* expr, int* status)
+ast *lat_analizar_expresion(lat_mv *mv, lat_arena *arena, char* expr, int* status)
 {
     setlocale (LC_ALL, "");
     ast *ret = NULL;
     yyscan_t scanner;
     YY_BUFFER_STATE state;
-    lex_state scan_state = {.insert = 0};
+    lex_state scan_state = {.insert = 0, .arena = arena};
     yylex_init_extra(&scan_state, &scanner);
     state = yy_scan_string(expr, scanner);
     *status = yyparse(&ret, scanner);
@@ -52,7 +51,7 @@ ast *lat_analizar_expresion(lat_mv *mv, char* expr, int* status)
     return ret;
 }
 
-ast *lat_analizar_archivo(lat_mv *mv, char *infile)
+ast *lat_analizar_archivo(lat_mv *mv, lat_arena *arena, char *infile)
 {
     if (infile == NULL)
     {
@@ -83,16 +82,12 @@ ast *lat_analizar_archivo(lat_mv *mv, char *infile)
     fseek(file, 0, SEEK_END);
     int fsize = ftell(file);
     fseek(file, 0, SEEK_SET);
-    buffer = calloc(fsize, 1);
+    /* el texto del programa vive en la arena hasta terminar de compilarlo */
+    char *buffer = (char*)lat_arena_asignar(arena, (size_t)fsize + 1);
     size_t newSize = fread(buffer, sizeof(char), fsize, file);
-    if (buffer == NULL)
-    {
-        printf("No se pudo asignar %d bytes de memoria\n", fsize);
-        return NULL;
-    }
     buffer[newSize] = '\0';
     int status;
-    return lat_analizar_expresion(mv, buffer, &status);
+    return lat_analizar_expresion(mv, arena, buffer, &status);
 }
 /**
  * Muestra la version de latino en la consola
@@ -121,6 +116,7 @@ void lat_ayuda()
     printf("%s\n", "Opciones:");
     printf("%s\n", "-a           : Muestra la ayuda de Latino");
     printf("%s\n", "-i           : Inicia el interprete de Latino (Modo interactivo)");
+    printf("%s\n", "-r           : Ejecuta las expresiones con instrucciones de registros");
     printf("%s\n", "-v           : Muestra la version de Latino");
     printf("%s\n", "archivo      : Nombre del archivo con extension .lat");
     printf("%s\n", "Ctrl-C       : Para cerrar");
@@ -148,7 +144,10 @@ static int leer_linea(lat_mv *mv, char* buffer){
         tmp = concat(tmp, "\n");
         tmp = concat(tmp, input);
         int estatus;
-        lat_analizar_expresion(mv, tmp, &estatus);
+        lat_arena arena;
+        lat_arena_iniciar(&arena);
+        lat_analizar_expresion(mv, &arena, tmp, &estatus);
+        lat_arena_liberar(&arena);
         if(estatus == 1){
             goto REPETIR;
         }else{
@@ -164,17 +163,23 @@ static void lat_repl(lat_mv *mv)
     char* buf = malloc(MAX_STR_INTERN);
     ast* tmp = NULL;
     int status;
+    lat_arena arena;
+    lat_arena_iniciar(&arena);
     mv->REPL = true;
     linenoiseHistoryLoad("history.txt");
     while (leer_linea(mv, buf) != -1)
     {
         analisis_silencioso = 0;
-        tmp = lat_analizar_expresion(mv, buf, &status);
-        if(tmp != NULL)
+        tmp = lat_analizar_expresion(mv, &arena, buf, &status);
+        if(tmp == NULL)
+        {
+            lat_arena_liberar(&arena);
+        }
+        else
         {
-            lat_objeto* curexpr = nodo_analizar_arbol(mv, tmp);
-            lat_objeto* resultado = lat_llamar_funcion(mv, curexpr);
-            if(resultado->tipo && !contains(buf, "escribir") && !contains(buf, "imprimir")){
+            lat_objeto* curexpr = nodo_analizar_arbol(mv, &arena, tmp);
+            lat_objeto* resultado = curexpr != NULL ? lat_llamar_funcion(mv, curexpr) : NULL;
+            if(resultado != NULL && lat_tipo(resultado) && !contains(buf, "escribir") && !contains(buf, "imprimir")){
                 lat_apilar(mv, resultado);
                 lat_imprimir(mv);
             }
@@ -201,17 +206,24 @@ int main(int argc, char *argv[])
         if (strcmp(argv[i], "-v") == 0)
         {
             lat_version();
+            lat_destruir_maquina_virtual(mv);
             return EXIT_SUCCESS;
         }
         else if (strcmp(argv[i], "-a") == 0)
         {
             lat_ayuda();
+            lat_destruir_maquina_virtual(mv);
             return EXIT_SUCCESS;
         }
+        else if (strcmp(argv[i], "-r") == 0)
+        {
+            mv->modo_registros = true;
+        }
         else if (strcmp(argv[i], "-i") == 0)
         {
             lat_version();
             lat_repl(mv);
+            lat_destruir_maquina_virtual(mv);
             return EXIT_SUCCESS;
         }
         else
@@ -222,12 +234,21 @@ int main(int argc, char *argv[])
     if(argc > 1 && infile != NULL)
     {
         mv->REPL = false;
-        ast *tree = lat_analizar_archivo(mv, infile);
+        lat_arena arena;
+        lat_arena_iniciar(&arena);
+        ast *tree = lat_analizar_archivo(mv, &arena, infile);
         if (!tree)
         {
+            lat_arena_liberar(&arena);
+            lat_destruir_maquina_virtual(mv);
+            return EXIT_FAILURE;
+        }
+        lat_objeto* mainFunc = nodo_analizar_arbol(mv, &arena, tree);
+        if (!mainFunc)
+        {
+            lat_destruir_maquina_virtual(mv);
             return EXIT_FAILURE;
         }
-        lat_objeto* mainFunc = nodo_analizar_arbol(mv, tree);
         //printf("---------------------------------------------\n");
         lat_llamar_funcion(mv, mainFunc);
         if(file != NULL)
@@ -247,5 +268,6 @@ int main(int argc, char *argv[])
 #endif
     }
 
+    lat_destruir_maquina_virtual(mv);
     return EXIT_SUCCESS;
 }
@@ -95,6 +95,13 @@ extern int debug;
 /** Indica que el analizador sintactico (bison) no debe emitir errores **/
 extern int analisis_silencioso;
 
+/** Numero maximo de atributos de una instancia con forma; con mas pasa a modo diccionario */
+#define MAX_ATRIBUTOS_FORMA 32
+/** Memoria de objetos (bytes) a partir de la cual la MV recolecta basura; despues de
+  * cada recoleccion el umbral es el doble de la memoria que sobrevivio */
+#define UMBRAL_RECOLECCION (4 * 1024 * 1024)
+/** Numero maximo de parametros y variables locales de una funcion */
+#define MAX_VARIABLES_LOCALES 256
 /** Tamanio maximo de instrucciones bytecode de una funcion */
 #define MAX_BYTECODE_FUNCTION (1024 * 10)
 /** Tamanio maximo de memoria virtual permitida */
@@ -103,8 +110,10 @@ extern int analisis_silencioso;
 #define MAX_STR_INTERN 64
 /** Tamanio maximo de una cadena almacenada dinamicamente */
 #define MAX_STR_LENGTH (1024*2)
-/** Tamanio maximo de la pila de la maquina virtual */
-#define MAX_STACK_SIZE 255
+/** Numero inicial de marcos de llamada (y de contextos) de la maquina virtual */
+#define TAMANIO_MARCOS_INICIAL 64
+/** Tamanio inicial de la pila de objetos de la maquina virtual */
+#define TAMANIO_PILA_INICIAL 256
 /** Tamanio maximo de una ruta de derectorio */
 #define MAX_PATH_LENGTH 1024
 /** Tamanio maximo de la entrada por teclado */
@@ -129,18 +138,20 @@ typedef struct YYLTYPE
 
 /** Analiza una cadena como expresion
   *
+  * \param arena: arena donde se crean los nodos y cadenas del arbol
   * \param expr: cadena a analizar
   * \return ast: Nodo AST
   *
   */
-ast* lat_analizar_expresion(lat_mv *mv, char* expr, int* status);
+ast* lat_analizar_expresion(lat_mv *mv, lat_arena *arena, char* expr, int* status);
 
 /** Analiza un archivo
   *
+  * \param arena: arena donde se crean el texto del archivo y el arbol
   * \param ruta: Ruta del archivo a analizar
   * \return ast: Nodo AST
   *
   */
-ast* lat_analizar_archivo(lat_mv *mv, char* ruta);
+ast* lat_analizar_archivo(lat_mv *mv, lat_arena *arena, char* ruta);
 
 #endif /* _LATINO_H_ */
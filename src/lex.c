@@ -475,7 +475,6 @@ static yyconst flex_int32_t yy_rule_can_match_eol[16] =
 #define YY_RESTORE_YY_MORE_OFFSET
 #line 1 "lex.l"
 #define YY_NO_UNISTD_H 1
-#define YY_NO_INPUT 1
 #line 12 "lex.l"
 
 /* flex -olex.c -i lex.l */
@@ -850,80 +849,125 @@ do_action:	/* This label is used only to access EOF actions. */
 			goto yy_find_action;
 
 case 1:
-#line 49 "lex.l"
+#line 47 "lex.l"
 case 2:
-#line 50 "lex.l"
+#line 48 "lex.l"
 case 3:
 YY_RULE_SETUP
-#line 50 "lex.l"
-{ return yytext[0]; }
+#line 49 "lex.l"
+{ yyextra->operando = (yytext[0] == ')'); return yytext[0]; }
 	YY_BREAK
 /* operadores de comparacion */
 case 4:
 YY_RULE_SETUP
-#line 53 "lex.l"
-{ return OP_EQ; }
+#line 52 "lex.l"
+{ yyextra->operando = 0; return OP_EQ; }
 	YY_BREAK
 /* palabras reservadas */
 case 5:
 YY_RULE_SETUP
-#line 56 "lex.l"
-{ return KIF; }
+#line 55 "lex.l"
+{ yyextra->operando = 0; return KIF; }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 57 "lex.l"
-{ return KEND; }
+#line 56 "lex.l"
+{ yyextra->operando = 0; return KEND; }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 58 "lex.l"
-{ return KELSE; }
+#line 57 "lex.l"
+{ yyextra->operando = 0; return KELSE; }
 	YY_BREAK
 /* names */
 case 8:
 YY_RULE_SETUP
-#line 61 "lex.l"
-{ yylval->node = nodo_nuevo_identificador(yytext, yylloc->first_line, yylloc->first_column); return TIDENTIFIER; }
+#line 60 "lex.l"
+{
+                            if (strcmp(yytext, "funcion") == 0) { yyextra->operando = 0; return KFUNCTION; }
+                            if (strcmp(yytext, "retorno") == 0) { yyextra->operando = 0; return KRETURN; }
+                            yyextra->operando = 1; yylval->node = nodo_nuevo_identificador(yyextra->arena, yytext, yylloc->first_line, yylloc->first_column); return TIDENTIFIER; }
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 62 "lex.l"
-{ yylval->node = nodo_nuevo_entero(strtol(yytext, NULL, 0), yylloc->first_line, yylloc->first_column); return TINT; }
+#line 64 "lex.l"
+{
+                                /* en "a-1" el signo es el operador y no parte del numero */
+                                if ((yytext[0] == '-' || yytext[0] == '+') && yyextra->operando) {
+                                    yyless(1);
+                                    yyextra->operando = 0;
+                                    return yytext[0];
+                                }
+                                yyextra->operando = 1;
+                                yylval->node = nodo_nuevo_entero(yyextra->arena, strtol(yytext, NULL, 0), yylloc->first_line, yylloc->first_column); return TINT;
+                            }
 	YY_BREAK
 case 10:
 /* rule 10 can match eol */
 YY_RULE_SETUP
-#line 63 "lex.l"
-{ yytext[strlen(yytext) - 1] = '\0'; yylval->node = nodo_nuevo_cadena(yytext+1, yylloc->first_line, yylloc->first_column); return TSTRING; }
+#line 74 "lex.l"
+{ yyextra->operando = 1; yytext[strlen(yytext) - 1] = '\0'; yylval->node = nodo_nuevo_cadena(yyextra->arena, yytext+1, yylloc->first_line, yylloc->first_column); return TSTRING; }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 64 "lex.l"
+#line 75 "lex.l"
 /* ignore comments */
 	YY_BREAK
 case 12:
 /* rule 12 can match eol */
 YY_RULE_SETUP
-#line 65 "lex.l"
-{ yycolumn = 1; }
+#line 76 "lex.l"
+{ yycolumn = 1; yyextra->operando = 0; }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 66 "lex.l"
+#line 77 "lex.l"
 { ; } /* ignora espacios en blanco y tabuladores */
 	YY_BREAK
+/* operadores aritmeticos y de comparacion; <=, >= y != se reconocen
+    revisando el caracter siguiente */
 case 14:
 YY_RULE_SETUP
-#line 67 "lex.l"
-{ ; } /* ignora caracteres incorrectos */
+#line 80 "lex.l"
+{
+                            int c = yytext[0];
+                            switch (c) {
+                            case '<':
+                            case '>':
+                            case '!':
+                                yyextra->operando = 0;
+                                if (yyg->yy_hold_char == '=') {
+                                    input(yyscanner);
+                                    return c == '<' ? OP_LE : (c == '>' ? OP_GE : OP_NEQ);
+                                }
+                                if (c != '!') {
+                                    return c;
+                                }
+                                break;
+                            case '+':
+                            case '-':
+                            case '*':
+                            case '/':
+                            case '%':
+                            case ',':
+                            case ':':
+                            case '[':
+                            case '{':
+                                yyextra->operando = 0;
+                                return c;
+                            case ']':
+                            case '}':
+                                yyextra->operando = 1;
+                                return c;
+                            }
+                        } /* ignora caracteres incorrectos */
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 69 "lex.l"
+#line 113 "lex.l"
 YY_FATAL_ERROR( "flex scanner jammed" );
 	YY_BREAK
-#line 927 "lex.c"
+#line 971 "lex.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -2068,7 +2112,7 @@ void yyfree (void * ptr , yyscan_t yyscanner)
 
 #define YYTABLES_NAME "yytables"
 
-#line 69 "lex.l"
+#line 113 "lex.l"
 
 
 
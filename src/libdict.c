@@ -0,0 +1,291 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 - Latino
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "libdict.h"
+
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "libmem.h"
+#include "libstring.h"
+#include "utils.h"
+
+/* capacidad de un diccionario nuevo, nunca es menor que un grupo */
+#define LAT_DIC_CAPACIDAD_INICIAL LAT_DIC_GRUPO
+
+/* las cadenas guardan su hash; los enteros usan la misma funcion sobre sus
+   bytes */
+static inline uint32_t lat_dic_hash(lat_objeto* llave)
+{
+    if (lat_tipo(llave) == T_INT)
+    {
+        long valor = lat_obtener_entero(llave);
+        uint64_t h = lat_hash(&valor, sizeof(valor));
+        return (uint32_t)(h ^ (h >> 32));
+    }
+    return llave->hash;
+}
+
+static inline uint8_t lat_dic_h2(uint32_t hash)
+{
+    return (uint8_t)(hash >> 25);
+}
+
+static inline bool lat_dic_llaves_iguales(lat_objeto* a, lat_objeto* b)
+{
+    if (a == b)
+    {
+        return true;
+    }
+    if (lat_tipo(a) != lat_tipo(b))
+    {
+        return false;
+    }
+    if (lat_tipo(a) == T_INT)
+    {
+        return lat_obtener_entero(a) == lat_obtener_entero(b);
+    }
+    return lat_cadenas_iguales(a, b);
+}
+
+/* un bit por cada una de las LAT_DIC_GRUPO entradas a partir de control
+   cuyo byte de control es c */
+static inline uint32_t lat_dic_coincidencias(const uint8_t* control, uint8_t c)
+{
+#if defined(__SSE2__)
+    __m128i grupo = _mm_loadu_si128((const __m128i*)control);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(grupo, _mm_set1_epi8((char)c)));
+#else
+    uint32_t mascara = 0;
+    int i;
+    for (i = 0; i < LAT_DIC_GRUPO; i++)
+    {
+        if (control[i] == c)
+        {
+            mascara |= 1u << i;
+        }
+    }
+    return mascara;
+#endif
+}
+
+static inline int lat_dic_primer_bit(uint32_t mascara)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(mascara);
+#else
+    int i = 0;
+    while ((mascara & 1u) == 0)
+    {
+        mascara >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/* los primeros LAT_DIC_GRUPO bytes de control se repiten al final para que
+   un grupo que empieza cerca del final se lea sin dar la vuelta */
+static inline void lat_dic_asignar_control(lat_diccionario* d, size_t i, uint8_t c)
+{
+    d->control[i] = c;
+    if (i < LAT_DIC_GRUPO)
+    {
+        d->control[d->capacidad + i] = c;
+    }
+}
+
+/* posicion de la llave o d->capacidad si no existe; con sondeo lineal la
+   llave no puede estar despues de la primera entrada vacia */
+static size_t lat_dic_buscar(lat_diccionario* d, lat_objeto* llave, uint32_t hash)
+{
+    size_t mascara = d->capacidad - 1;
+    size_t i = hash & mascara;
+    uint8_t h2 = lat_dic_h2(hash);
+    for (;;)
+    {
+        uint32_t vacias = lat_dic_coincidencias(&d->control[i], LAT_DIC_VACIO);
+        uint32_t candidatas = lat_dic_coincidencias(&d->control[i], h2);
+        if (vacias)
+        {
+            candidatas &= (vacias & (~vacias + 1)) - 1;
+        }
+        while (candidatas)
+        {
+            size_t j = (i + lat_dic_primer_bit(candidatas)) & mascara;
+            if (d->entradas[j].hash == hash && lat_dic_llaves_iguales(d->entradas[j].llave, llave))
+            {
+                return j;
+            }
+            candidatas &= candidatas - 1;
+        }
+        if (vacias)
+        {
+            return d->capacidad;
+        }
+        i = (i + LAT_DIC_GRUPO) & mascara;
+    }
+}
+
+/* primera entrada vacia a partir de la posicion inicial del hash */
+static size_t lat_dic_buscar_vacia(lat_diccionario* d, uint32_t hash)
+{
+    size_t mascara = d->capacidad - 1;
+    size_t i = hash & mascara;
+    for (;;)
+    {
+        uint32_t vacias = lat_dic_coincidencias(&d->control[i], LAT_DIC_VACIO);
+        if (vacias)
+        {
+            return (i + lat_dic_primer_bit(vacias)) & mascara;
+        }
+        i = (i + LAT_DIC_GRUPO) & mascara;
+    }
+}
+
+static void lat_dic_reservar(lat_diccionario* d, size_t capacidad)
+{
+    d->capacidad = capacidad;
+    d->control = (uint8_t*)lat_asignar_memoria(capacidad + LAT_DIC_GRUPO);
+    memset(d->control, LAT_DIC_VACIO, capacidad + LAT_DIC_GRUPO);
+    d->entradas = (lat_dic_entrada*)lat_asignar_memoria(sizeof(lat_dic_entrada) * capacidad);
+}
+
+/* duplica la capacidad, las entradas se reubican con el hash guardado */
+static void lat_dic_crecer(lat_diccionario* d)
+{
+    uint8_t* control = d->control;
+    lat_dic_entrada* entradas = d->entradas;
+    size_t capacidad = d->capacidad;
+    size_t i;
+    lat_dic_reservar(d, capacidad * 2);
+    for (i = 0; i < capacidad; i++)
+    {
+        if (control[i] != LAT_DIC_VACIO)
+        {
+            size_t j = lat_dic_buscar_vacia(d, entradas[i].hash);
+            d->entradas[j] = entradas[i];
+            lat_dic_asignar_control(d, j, control[i]);
+        }
+    }
+    lat_liberar_memoria(control);
+    lat_liberar_memoria(entradas);
+}
+
+lat_diccionario* lat_diccionario_crear(lat_mv* mv)
+{
+    lat_diccionario* d = (lat_diccionario*)lat_asignar_memoria(sizeof(lat_diccionario));
+    lat_dic_reservar(d, LAT_DIC_CAPACIDAD_INICIAL);
+    d->num_llaves = 0;
+    mv->memoria_usada += lat_diccionario_memoria(d);
+    return d;
+}
+
+void lat_diccionario_liberar(lat_diccionario* d)
+{
+    lat_liberar_memoria(d->control);
+    lat_liberar_memoria(d->entradas);
+    lat_liberar_memoria(d);
+}
+
+bool lat_diccionario_llave_valida(lat_objeto* llave)
+{
+    return lat_tipo(llave) == T_STR || lat_tipo(llave) == T_INT;
+}
+
+lat_objeto* lat_diccionario_obtener(lat_diccionario* d, lat_objeto* llave)
+{
+    size_t i = lat_dic_buscar(d, llave, lat_dic_hash(llave));
+    return i == d->capacidad ? NULL : d->entradas[i].valor;
+}
+
+void lat_diccionario_asignar(lat_mv* mv, lat_diccionario* d, lat_objeto* llave, lat_objeto* valor)
+{
+    uint32_t hash = lat_dic_hash(llave);
+    size_t i = lat_dic_buscar(d, llave, hash);
+    if (i != d->capacidad)
+    {
+        d->entradas[i].valor = valor;
+        return;
+    }
+    if ((d->num_llaves + 1) * 4 > d->capacidad * 3)
+    {
+        size_t antes = lat_diccionario_memoria(d);
+        lat_dic_crecer(d);
+        mv->memoria_usada += lat_diccionario_memoria(d) - antes;
+    }
+    i = lat_dic_buscar_vacia(d, hash);
+    d->entradas[i].llave = llave;
+    d->entradas[i].valor = valor;
+    d->entradas[i].hash = hash;
+    lat_dic_asignar_control(d, i, lat_dic_h2(hash));
+    d->num_llaves++;
+}
+
+bool lat_diccionario_eliminar(lat_diccionario* d, lat_objeto* llave)
+{
+    size_t mascara = d->capacidad - 1;
+    size_t i = lat_dic_buscar(d, llave, lat_dic_hash(llave));
+    size_t j = i;
+    if (i == d->capacidad)
+    {
+        return false;
+    }
+    /* las entradas siguientes se recorren al hueco mientras su posicion
+       inicial no quede entre el hueco y la entrada */
+    for (;;)
+    {
+        size_t inicio;
+        j = (j + 1) & mascara;
+        if (d->control[j] == LAT_DIC_VACIO)
+        {
+            break;
+        }
+        inicio = d->entradas[j].hash & mascara;
+        if (((j - inicio) & mascara) >= ((j - i) & mascara))
+        {
+            d->entradas[i] = d->entradas[j];
+            lat_dic_asignar_control(d, i, d->control[j]);
+            i = j;
+        }
+    }
+    d->entradas[i].llave = NULL;
+    d->entradas[i].valor = NULL;
+    lat_dic_asignar_control(d, i, LAT_DIC_VACIO);
+    d->num_llaves--;
+    return true;
+}
+
+lat_diccionario* lat_diccionario_copiar(lat_mv* mv, lat_diccionario* d)
+{
+    lat_diccionario* ret = (lat_diccionario*)lat_asignar_memoria(sizeof(lat_diccionario));
+    lat_dic_reservar(ret, d->capacidad);
+    memcpy(ret->control, d->control, d->capacidad + LAT_DIC_GRUPO);
+    memcpy(ret->entradas, d->entradas, sizeof(lat_dic_entrada) * d->capacidad);
+    ret->num_llaves = d->num_llaves;
+    mv->memoria_usada += lat_diccionario_memoria(ret);
+    return ret;
+}
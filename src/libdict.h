@@ -0,0 +1,130 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 - Latino
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef _LIBDICT_H_
+#define _LIBDICT_H_
+
+#include <stdint.h>
+
+#include "latino.h"
+#include "object.h"
+
+/** \file libdict.h
+*
+* Contiene las funciones para el manejo de diccionarios
+*
+*/
+
+/** Numero de entradas que se revisan juntas al buscar una llave */
+#define LAT_DIC_GRUPO 16
+
+/** \brief Entrada de un diccionario */
+typedef struct lat_dic_entrada
+{
+    lat_objeto* llave;      /**< Llave (cadena o entero) */
+    lat_objeto* valor;      /**< Valor */
+    uint32_t hash;          /**< Hash de la llave, se calcula una sola vez al insertarla */
+} lat_dic_entrada;
+
+/** \brief Diccionario
+*
+* Tabla con direccionamiento abierto y sondeo lineal. Por cada entrada se
+* guarda un byte de control: LAT_DIC_VACIO o los 7 bits altos del hash de la
+* llave. Una busqueda compara los bytes de control de LAT_DIC_GRUPO entradas
+* a la vez (con SSE2 si esta disponible) y solo compara las llaves cuyo byte
+* coincide. Al eliminar se recorren hacia atras las entradas siguientes, por
+* lo que no se necesitan marcas de borrado.
+*/
+typedef struct lat_diccionario
+{
+    uint8_t* control;           /**< Bytes de control (capacidad + LAT_DIC_GRUPO, los primeros se repiten al final) */
+    lat_dic_entrada* entradas;  /**< Arreglo de entradas */
+    size_t capacidad;           /**< Numero de entradas reservadas (potencia de 2) */
+    size_t num_llaves;          /**< Numero de entradas ocupadas */
+} lat_diccionario;
+
+/** Byte de control de una entrada vacia */
+#define LAT_DIC_VACIO 0x80
+
+/** Memoria que reserva un diccionario: la estructura, los bytes de control y
+  * las entradas */
+#define lat_diccionario_memoria(d) (sizeof(lat_diccionario) + (d)->capacidad + LAT_DIC_GRUPO + sizeof(lat_dic_entrada) * (d)->capacidad)
+
+/** Crea un diccionario vacio; su memoria se suma a la memoria usada de la MV
+  *
+  * \param mv: Maquina virtual
+  * \return lat_diccionario: Apuntador al diccionario
+  */
+lat_diccionario* lat_diccionario_crear(lat_mv* mv);
+
+/** Libera un diccionario sin liberar las llaves ni los valores; quien lo
+  * libera fuera del barrido descuenta lat_diccionario_memoria de la MV
+  *
+  * \param d: Apuntador al diccionario
+  */
+void lat_diccionario_liberar(lat_diccionario* d);
+
+/** Valida que un objeto se pueda usar como llave (cadena o entero)
+  *
+  * \param llave: Objeto
+  * \return bool: verdadero si es una llave valida
+  */
+bool lat_diccionario_llave_valida(lat_objeto* llave);
+
+/** Obtiene el valor de una llave
+  *
+  * \param d: Apuntador al diccionario
+  * \param llave: Llave buscada
+  * \return lat_objeto: Valor o NULL si la llave no existe
+  */
+lat_objeto* lat_diccionario_obtener(lat_diccionario* d, lat_objeto* llave);
+
+/** Asigna el valor de una llave, la agrega si no existe; si la tabla crece
+  * la memoria nueva se suma a la memoria usada de la MV
+  *
+  * \param mv: Maquina virtual
+  * \param d: Apuntador al diccionario
+  * \param llave: Llave
+  * \param valor: Valor
+  */
+void lat_diccionario_asignar(lat_mv* mv, lat_diccionario* d, lat_objeto* llave, lat_objeto* valor);
+
+/** Elimina una llave
+  *
+  * \param d: Apuntador al diccionario
+  * \param llave: Llave
+  * \return bool: verdadero si la llave existia
+  */
+bool lat_diccionario_eliminar(lat_diccionario* d, lat_objeto* llave);
+
+/** Copia un diccionario (las llaves y valores se comparten); su memoria se
+  * suma a la memoria usada de la MV
+  *
+  * \param mv: Maquina virtual
+  * \param d: Apuntador al diccionario
+  * \return lat_diccionario: Apuntador a la copia
+  */
+lat_diccionario* lat_diccionario_copiar(lat_mv* mv, lat_diccionario* d);
+
+#endif // !_LIBDICT_H_
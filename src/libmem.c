@@ -23,6 +23,7 @@ THE SOFTWARE.
 */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "libmem.h"
 #include "utils.h"
@@ -50,3 +51,261 @@ void lat_liberar_memoria(void* ptr)
         free(ptr);
     }
 }
+
+/* las paginas se reservan alineadas a su tamanio */
+static lat_pagina* lat_slab_reservar_pagina(void)
+{
+#ifdef _WIN32
+    void* p = _aligned_malloc(LAT_SLAB_PAGINA, LAT_SLAB_PAGINA);
+#else
+    void* p = aligned_alloc(LAT_SLAB_PAGINA, LAT_SLAB_PAGINA);
+#endif
+    if (p == NULL)
+        lat_registrar_error("Memoria virtual agotada\n");
+    return (lat_pagina*)p;
+}
+
+static void lat_slab_liberar_pagina(lat_pagina* pagina)
+{
+#ifdef _WIN32
+    _aligned_free(pagina);
+#else
+    free(pagina);
+#endif
+}
+
+static void lat_slab_agregar_libre(lat_slab* slab, lat_pagina* pagina)
+{
+    pagina->anterior_libre = NULL;
+    pagina->siguiente_libre = slab->con_libres;
+    if (slab->con_libres != NULL)
+    {
+        slab->con_libres->anterior_libre = pagina;
+    }
+    slab->con_libres = pagina;
+}
+
+static void lat_slab_quitar_libre(lat_slab* slab, lat_pagina* pagina)
+{
+    if (pagina->anterior_libre != NULL)
+    {
+        pagina->anterior_libre->siguiente_libre = pagina->siguiente_libre;
+    }
+    else
+    {
+        slab->con_libres = pagina->siguiente_libre;
+    }
+    if (pagina->siguiente_libre != NULL)
+    {
+        pagina->siguiente_libre->anterior_libre = pagina->anterior_libre;
+    }
+}
+
+/* saca la pagina de las dos listas del slab y la libera */
+static void lat_slab_quitar_pagina(lat_slab* slab, lat_pagina* pagina)
+{
+    lat_slab_quitar_libre(slab, pagina);
+    if (pagina->anterior != NULL)
+    {
+        pagina->anterior->siguiente = pagina->siguiente;
+    }
+    else
+    {
+        slab->paginas = pagina->siguiente;
+    }
+    if (pagina->siguiente != NULL)
+    {
+        pagina->siguiente->anterior = pagina->anterior;
+    }
+    slab->num_paginas--;
+    lat_slab_liberar_pagina(pagina);
+}
+
+static lat_pagina* lat_slab_nueva_pagina(lat_slab* slab)
+{
+    lat_pagina* pagina = lat_slab_reservar_pagina();
+    size_t encabezado = (sizeof(lat_pagina) + LAT_SLAB_ALINEACION - 1) & ~(size_t)(LAT_SLAB_ALINEACION - 1);
+    pagina->slab = slab;
+    pagina->libres = NULL;
+    pagina->celdas = (char*)pagina + encabezado;
+    pagina->num_celdas = (LAT_SLAB_PAGINA - encabezado) / slab->tamanio_celda;
+    pagina->nuevas = 0;
+    pagina->ocupadas = 0;
+    memset(pagina->mapa, 0, sizeof(pagina->mapa));
+    pagina->anterior = NULL;
+    pagina->siguiente = slab->paginas;
+    if (slab->paginas != NULL)
+    {
+        slab->paginas->anterior = pagina;
+    }
+    slab->paginas = pagina;
+    slab->num_paginas++;
+    lat_slab_agregar_libre(slab, pagina);
+    return pagina;
+}
+
+void lat_slab_iniciar(lat_slab* slab, size_t tamanio_celda)
+{
+    slab->tamanio_celda = (tamanio_celda + LAT_SLAB_ALINEACION - 1) & ~(size_t)(LAT_SLAB_ALINEACION - 1);
+    slab->paginas = NULL;
+    slab->con_libres = NULL;
+    slab->num_paginas = 0;
+    slab->ocupadas = 0;
+}
+
+void* lat_slab_asignar(lat_slab* slab)
+{
+    lat_pagina* pagina = slab->con_libres;
+    char* celda;
+    size_t i;
+    if (pagina == NULL)
+    {
+        pagina = lat_slab_nueva_pagina(slab);
+    }
+    if (pagina->libres != NULL)
+    {
+        celda = (char*)pagina->libres;
+        pagina->libres = pagina->libres->siguiente;
+    }
+    else
+    {
+        celda = pagina->celdas + pagina->nuevas * slab->tamanio_celda;
+        pagina->nuevas++;
+    }
+    i = (size_t)(celda - pagina->celdas) / slab->tamanio_celda;
+    pagina->mapa[i / 8] |= (uint8_t)(1u << (i % 8));
+    pagina->ocupadas++;
+    slab->ocupadas++;
+    if (pagina->ocupadas == pagina->num_celdas)
+    {
+        lat_slab_quitar_libre(slab, pagina);
+    }
+    return celda;
+}
+
+void lat_slab_devolver(void* p)
+{
+    lat_pagina* pagina = lat_slab_pagina(p);
+    lat_slab* slab = pagina->slab;
+    size_t i = (size_t)((char*)p - pagina->celdas) / slab->tamanio_celda;
+    pagina->mapa[i / 8] &= (uint8_t)~(1u << (i % 8));
+    if (pagina->ocupadas == pagina->num_celdas)
+    {
+        lat_slab_agregar_libre(slab, pagina);
+    }
+    pagina->ocupadas--;
+    slab->ocupadas--;
+    if (pagina->ocupadas == 0 && (pagina->anterior_libre != NULL || pagina->siguiente_libre != NULL))
+    {
+        /* la pagina vacia se devuelve al sistema si hay otra con espacio */
+        lat_slab_quitar_pagina(slab, pagina);
+        return;
+    }
+    ((lat_celda*)p)->siguiente = pagina->libres;
+    pagina->libres = (lat_celda*)p;
+}
+
+size_t lat_slab_barrer(lat_slab* slab, bool (*recolectar)(void* celda, void* dato), void* dato)
+{
+    size_t liberadas = 0;
+    lat_pagina* pagina = slab->paginas;
+    while (pagina != NULL)
+    {
+        lat_pagina* siguiente = pagina->siguiente;
+        bool llena = pagina->ocupadas == pagina->num_celdas;
+        size_t i;
+        for (i = 0; i < pagina->nuevas; i++)
+        {
+            char* celda = pagina->celdas + i * slab->tamanio_celda;
+            if (lat_pagina_ocupada(pagina, i) && recolectar(celda, dato))
+            {
+                pagina->mapa[i / 8] &= (uint8_t)~(1u << (i % 8));
+                ((lat_celda*)celda)->siguiente = pagina->libres;
+                pagina->libres = (lat_celda*)celda;
+                pagina->ocupadas--;
+                slab->ocupadas--;
+                liberadas++;
+            }
+        }
+        if (llena && pagina->ocupadas < pagina->num_celdas)
+        {
+            lat_slab_agregar_libre(slab, pagina);
+        }
+        if (pagina->ocupadas == 0 && slab->num_paginas > 1)
+        {
+            lat_slab_quitar_pagina(slab, pagina);
+        }
+        pagina = siguiente;
+    }
+    return liberadas;
+}
+
+void lat_slab_destruir(lat_slab* slab)
+{
+    lat_pagina* pagina = slab->paginas;
+    while (pagina != NULL)
+    {
+        lat_pagina* siguiente = pagina->siguiente;
+        lat_slab_liberar_pagina(pagina);
+        pagina = siguiente;
+    }
+    lat_slab_iniciar(slab, slab->tamanio_celda);
+}
+
+double lat_slab_ocupacion(const lat_slab* slab)
+{
+    size_t celdas = 0;
+    const lat_pagina* pagina;
+    for (pagina = slab->paginas; pagina != NULL; pagina = pagina->siguiente)
+    {
+        celdas += pagina->num_celdas;
+    }
+    return celdas == 0 ? 0.0 : 100.0 * (double)slab->ocupadas / (double)celdas;
+}
+
+/* los datos de un bloque empiezan alineados despues de su encabezado */
+#define LAT_ARENA_ENCABEZADO ((sizeof(lat_bloque_arena) + LAT_SLAB_ALINEACION - 1) & ~(size_t)(LAT_SLAB_ALINEACION - 1))
+
+void lat_arena_iniciar(lat_arena* arena)
+{
+    arena->bloque = NULL;
+}
+
+void* lat_arena_asignar(lat_arena* arena, size_t tamanio)
+{
+    lat_bloque_arena* b = arena->bloque;
+    void* ret;
+    tamanio = (tamanio + LAT_SLAB_ALINEACION - 1) & ~(size_t)(LAT_SLAB_ALINEACION - 1);
+    if (b == NULL || b->tamanio - b->usado < tamanio)
+    {
+        size_t disponible = tamanio > LAT_ARENA_BLOQUE ? tamanio : LAT_ARENA_BLOQUE;
+        b = (lat_bloque_arena*)lat_asignar_memoria(LAT_ARENA_ENCABEZADO + disponible);
+        b->anterior = arena->bloque;
+        b->tamanio = disponible;
+        b->usado = 0;
+        arena->bloque = b;
+    }
+    ret = (char*)b + LAT_ARENA_ENCABEZADO + b->usado;
+    b->usado += tamanio;
+    return ret;
+}
+
+char* lat_arena_copiar(lat_arena* arena, const char* s, size_t len)
+{
+    char* ret = (char*)lat_arena_asignar(arena, len + 1);
+    memcpy(ret, s, len);
+    ret[len] = '\0';
+    return ret;
+}
+
+void lat_arena_liberar(lat_arena* arena)
+{
+    lat_bloque_arena* b = arena->bloque;
+    while (b != NULL)
+    {
+        lat_bloque_arena* anterior = b->anterior;
+        lat_liberar_memoria(b);
+        b = anterior;
+    }
+    arena->bloque = NULL;
+}
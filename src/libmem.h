@@ -26,6 +26,8 @@ THE SOFTWARE.
 #define _LIBMEM_H_
 
 #include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 /** \file libmem.h
 *
@@ -55,4 +57,154 @@ void* lat_reasignar_memoria(void* ptr, size_t size);
   */
 void lat_liberar_memoria(void* ptr);
 
+/** \brief Tamanio de una pagina de slab; cada pagina esta alineada a su
+  * tamanio para encontrar su encabezado a partir de cualquier celda */
+#define LAT_SLAB_PAGINA (64 * 1024)
+
+/** \brief Las celdas miden un multiplo de LAT_SLAB_ALINEACION bytes */
+#define LAT_SLAB_ALINEACION 16
+
+struct lat_slab;
+
+/** \brief Celda libre: la lista de libres se guarda dentro de las celdas */
+typedef struct lat_celda
+{
+    struct lat_celda* siguiente;
+} lat_celda;
+
+/** \brief Pagina de un slab
+  *
+  * El encabezado ocupa el inicio de la pagina y le siguen las celdas. Las
+  * celdas que nunca se han usado se toman en orden (nuevas); las que se
+  * devuelven van a la lista libres de su pagina.
+  */
+typedef struct lat_pagina
+{
+    struct lat_slab* slab;  /**< Slab al que pertenece */
+    struct lat_pagina* anterior;    /**< Lista de todas las paginas del slab */
+    struct lat_pagina* siguiente;
+    struct lat_pagina* anterior_libre;  /**< Lista de paginas con celdas libres */
+    struct lat_pagina* siguiente_libre;
+    lat_celda* libres;      /**< Celdas devueltas */
+    char* celdas;           /**< Primera celda */
+    size_t num_celdas;      /**< Celdas en la pagina */
+    size_t nuevas;          /**< Celdas usadas alguna vez (las demas estan sin tocar) */
+    size_t ocupadas;        /**< Celdas asignadas */
+    uint8_t mapa[LAT_SLAB_PAGINA / LAT_SLAB_ALINEACION / 8];  /**< Un bit por celda asignada */
+} lat_pagina;
+
+/** \brief Slab: celdas de un solo tamanio tomadas de paginas grandes */
+typedef struct lat_slab
+{
+    size_t tamanio_celda;   /**< Tamanio de cada celda */
+    lat_pagina* paginas;    /**< Todas las paginas */
+    lat_pagina* con_libres; /**< Paginas con al menos una celda libre */
+    size_t num_paginas;     /**< Paginas reservadas */
+    size_t ocupadas;        /**< Celdas asignadas en todas las paginas */
+} lat_slab;
+
+/** \brief Pagina que contiene la celda p */
+#define lat_slab_pagina(p) ((lat_pagina*)((uintptr_t)(p) & ~(uintptr_t)(LAT_SLAB_PAGINA - 1)))
+
+/** \brief Indica si la celda i de la pagina esta asignada */
+#define lat_pagina_ocupada(pagina, i) (((pagina)->mapa[(i) / 8] >> ((i) % 8)) & 1)
+
+/** Inicializa un slab vacio
+  *
+  * \param slab: Slab a inicializar
+  * \param tamanio_celda: Tamanio de las celdas (se redondea a LAT_SLAB_ALINEACION)
+  *
+  */
+void lat_slab_iniciar(lat_slab* slab, size_t tamanio_celda);
+
+/** Asigna una celda del slab
+  *
+  * \param slab: Slab del que se toma la celda
+  *
+  */
+void* lat_slab_asignar(lat_slab* slab);
+
+/** Devuelve una celda a su pagina; la pagina se libera si queda vacia y el
+  * slab tiene otra pagina con celdas libres
+  *
+  * \param p: Celda asignada con lat_slab_asignar
+  *
+  */
+void lat_slab_devolver(void* p);
+
+/** Recorre las celdas asignadas del slab y devuelve las que indique
+  * recolectar; las paginas que quedan vacias se liberan (queda al menos una)
+  *
+  * \param slab: Slab a recorrer
+  * \param recolectar: Regresa verdadero si la celda se debe devolver
+  * \param dato: Se pasa a recolectar
+  * \return size_t: Numero de celdas devueltas
+  *
+  */
+size_t lat_slab_barrer(lat_slab* slab, bool (*recolectar)(void* celda, void* dato), void* dato);
+
+/** Libera todas las paginas del slab
+  *
+  * \param slab: Slab a vaciar
+  *
+  */
+void lat_slab_destruir(lat_slab* slab);
+
+/** Porcentaje de celdas asignadas del slab sobre las celdas de sus paginas,
+  * p. ej. lat_slab_ocupacion(&mv->objetos)
+  *
+  * \param slab: Slab a consultar
+  *
+  */
+double lat_slab_ocupacion(const lat_slab* slab);
+
+/** \brief Tamanio minimo de cada bloque de una arena */
+#define LAT_ARENA_BLOQUE (32 * 1024)
+
+/** \brief Bloque de una arena; los datos empiezan despues del encabezado */
+typedef struct lat_bloque_arena
+{
+    struct lat_bloque_arena* anterior;  /**< Bloque reservado antes */
+    size_t tamanio;         /**< Bytes disponibles en el bloque */
+    size_t usado;           /**< Bytes asignados del bloque */
+} lat_bloque_arena;
+
+/** \brief Arena: memoria que se asigna incrementando un apuntador y se
+  * libera completa de una sola vez */
+typedef struct lat_arena
+{
+    lat_bloque_arena* bloque;   /**< Bloque actual */
+} lat_arena;
+
+/** Inicializa una arena vacia
+  *
+  * \param arena: Arena a inicializar
+  *
+  */
+void lat_arena_iniciar(lat_arena* arena);
+
+/** Asigna memoria de la arena, alineada a LAT_SLAB_ALINEACION
+  *
+  * \param arena: Arena
+  * \param tamanio: Tamanio de memoria solicitado
+  *
+  */
+void* lat_arena_asignar(lat_arena* arena, size_t tamanio);
+
+/** Copia una cadena en la arena y le agrega el terminador
+  *
+  * \param arena: Arena
+  * \param s: Cadena a copiar
+  * \param len: Longitud de la cadena
+  *
+  */
+char* lat_arena_copiar(lat_arena* arena, const char* s, size_t len);
+
+/** Libera toda la memoria de la arena, que queda vacia para usarse de nuevo
+  *
+  * \param arena: Arena
+  *
+  */
+void lat_arena_liberar(lat_arena* arena);
+
 #endif /*_LIBMEM_H_*/
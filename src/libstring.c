@@ -22,6 +22,10 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
 #include "khash.h"
 #include "latino.h"
 #include "object.h"
@@ -32,76 +36,187 @@ KHASH_MAP_INIT_INT64(env, lat_objeto);
 typedef khash_t(env) lat_env;
 lat_env* globals;
 
-struct sym_key
+/* las cadenas cortas se internan en una tabla compartida por todas las
+ * maquinas virtuales del proceso. La tabla se divide en franjas segun los
+ * bits altos del hash: las busquedas no toman candados y una insercion solo
+ * bloquea su franja. Una tabla que crece se publica con un solo store
+ * atomico; la anterior no se libera porque un lector puede seguir en ella */
+#define INTERN_BITS_FRANJAS 6
+#define INTERN_NUM_FRANJAS (1 << INTERN_BITS_FRANJAS)
+#define INTERN_CAPACIDAD_INICIAL 64
+
+typedef struct intern_tabla
 {
-    const char* ptr;
-    size_t len;
-};
+    size_t capacidad;                   /* potencia de 2, se llena a lo mas a la mitad */
+    struct intern_tabla* anterior;      /* tabla reemplazada al crecer */
+    _Atomic(lat_objeto*) ranuras[];
+} intern_tabla;
+
+typedef struct intern_franja
+{
+    _Atomic(intern_tabla*) tabla;
+    atomic_bool ocupada;                /* candado de las inserciones */
+    size_t num_cadenas;
+} intern_franja;
+
+static intern_franja franjas[INTERN_NUM_FRANJAS];
 
-static khint_t
-sym_hash(struct sym_key key)
+static uint32_t str_hash(const char* p, size_t len)
 {
-    const char* s = key.ptr;
-    khint_t h;
-    size_t len = key.len;
-    h = *s++;
-    while (len--)
+    uint64_t h = lat_hash(p, len);
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+/* la cadena guarda su propia copia: el texto original puede estar en la
+   arena del analisis o en un buffer temporal. Es un objeto de la MV y la
+   libera el colector de basura */
+static lat_objeto* str_new(lat_mv* mv, const char* p, size_t len)
+{
+    lat_objeto* str = lat_crear_objeto(mv);
+    char* copia = NULL;
+    if (p != NULL)
     {
-        h = (h << 5) - h + (khint_t)*s++;
+        copia = (char*)lat_asignar_memoria(len + 1);
+        memcpy(copia, p, len);
+        copia[len] = '\0';
+        mv->memoria_usada += len + 1;
     }
-    return h;
+    str->tipo = T_STR;
+    str->tamanio_datos = len;
+    str->datos.cadena = copia;
+    /* el hash se guarda en la cadena para las tablas hash */
+    str->hash = p ? str_hash(p, len) : 0;
+    return str;
 }
 
-static khint_t
-sym_eq(struct sym_key a, struct sym_key b)
+static intern_tabla* intern_crear_tabla(size_t capacidad)
 {
-    if (a.len != b.len)
-        return false;
-    if (memcmp(a.ptr, b.ptr, a.len) == 0)
-        return true;
-    return false;
+    intern_tabla* t = (intern_tabla*)lat_asignar_memoria(sizeof(intern_tabla) + sizeof(_Atomic(lat_objeto*)) * capacidad);
+    size_t i;
+    t->capacidad = capacidad;
+    t->anterior = NULL;
+    for (i = 0; i < capacidad; i++)
+    {
+        atomic_init(&t->ranuras[i], NULL);
+    }
+    return t;
 }
 
-KHASH_INIT(sym, struct sym_key, lat_objeto*, 1, sym_hash, sym_eq);
-static khash_t(sym) * sym_table;
+static lat_objeto* intern_buscar(intern_tabla* t, const char* p, size_t len, uint32_t hash)
+{
+    size_t mascara;
+    size_t i;
+    if (t == NULL)
+    {
+        return NULL;
+    }
+    mascara = t->capacidad - 1;
+    for (i = hash & mascara;; i = (i + 1) & mascara)
+    {
+        lat_objeto* str = atomic_load_explicit(&t->ranuras[i], memory_order_acquire);
+        if (str == NULL)
+        {
+            return NULL;
+        }
+        if (str->hash == hash && str->tamanio_datos == len && memcmp(str->datos.cadena, p, len) == 0)
+        {
+            return str;
+        }
+    }
+}
 
-static lat_objeto* str_new(const char* p, size_t len)
+/* solo se llama con el candado de la franja */
+static void intern_colocar(intern_tabla* t, lat_objeto* str)
 {
-    lat_objeto* str = (lat_objeto*)lat_asignar_memoria(sizeof(lat_objeto));
-    str->tipo = T_STR;
-    str->tamanio_datos = len;
-    str->datos.cadena = (char *)p;
-    return str;
+    size_t mascara = t->capacidad - 1;
+    size_t i = str->hash & mascara;
+    while (atomic_load_explicit(&t->ranuras[i], memory_order_relaxed) != NULL)
+    {
+        i = (i + 1) & mascara;
+    }
+    atomic_store_explicit(&t->ranuras[i], str, memory_order_release);
 }
 
 static lat_objeto* str_intern(const char* p, size_t len)
 {
-    khiter_t k;
-    struct sym_key key;
-    int ret;
-    lat_objeto* str;
-    if (!sym_table)
+    uint32_t hash = str_hash(p, len);
+    intern_franja* f = &franjas[hash >> (32 - INTERN_BITS_FRANJAS)];
+    intern_tabla* t = atomic_load_explicit(&f->tabla, memory_order_acquire);
+    lat_objeto* str = intern_buscar(t, p, len, hash);
+    char* copia;
+    if (str != NULL)
+    {
+        return str;
+    }
+    while (atomic_exchange_explicit(&f->ocupada, true, memory_order_acquire))
     {
-        sym_table = kh_init(sym);
+        ;
     }
-    key.ptr = p;
-    key.len = len;
-    k = kh_put(sym, sym_table, key, &ret);
-    if (ret == 0)
+    /* otro hilo pudo insertarla mientras se esperaba el candado */
+    t = atomic_load_explicit(&f->tabla, memory_order_relaxed);
+    str = intern_buscar(t, p, len, hash);
+    if (str == NULL)
     {
-        return kh_value(sym_table, k);
+        if (t == NULL || (f->num_cadenas + 1) * 2 > t->capacidad)
+        {
+            intern_tabla* nueva = intern_crear_tabla(t == NULL ? INTERN_CAPACIDAD_INICIAL : t->capacidad * 2);
+            size_t i;
+            nueva->anterior = t;
+            for (i = 0; t != NULL && i < t->capacidad; i++)
+            {
+                lat_objeto* s = atomic_load_explicit(&t->ranuras[i], memory_order_relaxed);
+                if (s != NULL)
+                {
+                    intern_colocar(nueva, s);
+                }
+            }
+            atomic_store_explicit(&f->tabla, nueva, memory_order_release);
+            t = nueva;
+        }
+        /* la cadena internada es de todo el proceso: se copian los bytes */
+        copia = (char*)lat_asignar_memoria(len + 1);
+        memcpy(copia, p, len);
+        copia[len] = '\0';
+        str = (lat_objeto*)lat_asignar_memoria(sizeof(lat_objeto));
+        str->tipo = T_STR;
+        str->marcado = 0;
+        /* compartida entre todas las MV */
+        str->inmortal = true;
+        str->es_constante = false;
+        str->num_declarado = 0;
+        str->tamanio_datos = len;
+        str->datos.cadena = copia;
+        str->hash = hash;
+        intern_colocar(t, str);
+        f->num_cadenas++;
     }
-    str = str_new(p, len);
-    kh_key(sym_table, k).ptr = str->datos.cadena;
-    kh_value(sym_table, k) = str;
+    atomic_store_explicit(&f->ocupada, false, memory_order_release);
     return str;
 }
 
-lat_objeto* lat_cadena_hash(const char* p, size_t len)
+lat_objeto* lat_cadena_hash(lat_mv *mv, const char* p, size_t len)
 {
     if (p && (len < MAX_STR_INTERN))
     {
         return str_intern(p, len);
     }
-    return str_new(p, len);
+    return str_new(mv, p, len);
+}
+
+lat_objeto* lat_cadena_internar(const char* p, size_t len)
+{
+    return str_intern(p, len);
+}
+
+lat_objeto* lat_cadena_concatenar(lat_mv *mv, const char* a, size_t la, const char* b, size_t lb)
+{
+    lat_objeto* str = str_new(mv, NULL, la + lb);
+    char* texto = (char*)lat_asignar_memoria(la + lb + 1);
+    memcpy(texto, a, la);
+    memcpy(texto + la, b, lb);
+    texto[la + lb] = '\0';
+    mv->memoria_usada += la + lb + 1;
+    str->datos.cadena = texto;
+    str->hash = str_hash(texto, la + lb);
+    return str;
 }
@@ -25,7 +25,10 @@ THE SOFTWARE.
 #ifndef _LIBSTRING_H_
 #define _LIBSTRING_H_
 
+#include <string.h>
+
 #include "latino.h"
+#include "object.h"
 
 /** \file libstring.h
 *
@@ -33,13 +36,86 @@ THE SOFTWARE.
 *
 */
 
-/** Guarda un cadena en hashtable
+/** Cadena para los nombres y constantes que genera el compilador; el objeto
+  * guarda su propia copia del texto. Las cadenas cortas se internan y son de
+  * todo el proceso; las largas son objetos de la MV y las libera el colector
+  * de basura
   *
+  * \param mv: Maquina virtual duenia de las cadenas largas
   * \param p: Apuntador a la cadena a guardar
   * \param len: Longitud de la cadena
   * \return lat_objeto: Un objeto tipo cadena
   *
   */
-lat_objeto* lat_cadena_hash(const char* p, size_t len);
+lat_objeto* lat_cadena_hash(lat_mv *mv, const char* p, size_t len);
+
+/** Cadena internada de cualquier longitud: es de todo el proceso y nunca se
+  * libera (p. ej. los nombres de atributos de las formas)
+  *
+  * \param p: Apuntador a la cadena
+  * \param len: Longitud de la cadena
+  * \return lat_objeto: La cadena internada
+  *
+  */
+lat_objeto* lat_cadena_internar(const char* p, size_t len);
+
+/** Concatena dos textos en una cadena creada al ejecutar el programa: no se
+  * interna, es un objeto de la MV que libera el colector de basura
+  *
+  * \param mv: Maquina virtual
+  * \param a: Primer texto
+  * \param la: Longitud del primer texto
+  * \param b: Segundo texto
+  * \param lb: Longitud del segundo texto
+  * \return lat_objeto: Un objeto tipo cadena
+  *
+  */
+lat_objeto* lat_cadena_concatenar(lat_mv *mv, const char* a, size_t la, const char* b, size_t lb);
+
+/** Longitud en bytes de una cadena, se guarda al crearla */
+#define lat_cadena_longitud(o) ((o)->tamanio_datos)
+
+/** Compara dos cadenas usando el hash y la longitud que guardan; solo si
+  * ambos coinciden se compara el contenido (una cadena creada al ejecutar el
+  * programa puede tener el mismo texto que una internada)
+  *
+  * \param a: Cadena
+  * \param b: Cadena
+  * \return bool: verdadero si tienen el mismo contenido
+  */
+static inline bool lat_cadenas_iguales(lat_objeto* a, lat_objeto* b)
+{
+    if (a == b)
+    {
+        return true;
+    }
+    if (a->hash != b->hash || a->tamanio_datos != b->tamanio_datos)
+    {
+        return false;
+    }
+    return memcmp(a->datos.cadena, b->datos.cadena, a->tamanio_datos) == 0;
+}
+
+/** Orden de dos cadenas
+  *
+  * \param a: Cadena
+  * \param b: Cadena
+  * \return int: -1, 0 o 1
+  */
+static inline int lat_cadena_comparar(lat_objeto* a, lat_objeto* b)
+{
+    size_t n = a->tamanio_datos < b->tamanio_datos ? a->tamanio_datos : b->tamanio_datos;
+    int cmp;
+    if (a == b)
+    {
+        return 0;
+    }
+    cmp = memcmp(a->datos.cadena, b->datos.cadena, n);
+    if (cmp == 0)
+    {
+        cmp = (a->tamanio_datos > b->tamanio_datos) - (a->tamanio_datos < b->tamanio_datos);
+    }
+    return (cmp > 0) - (cmp < 0);
+}
 
 #endif // !_LIBSTRING_H_
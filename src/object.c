@@ -27,71 +27,217 @@ THE SOFTWARE.
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 
 #include "latino.h"
 #include "utils.h"
 #include "libstring.h"
+#include "libdict.h"
 #include "libmem.h"
 
-void lat_asignar_contexto_objeto(lat_objeto* ns, lat_objeto* name, lat_objeto* o)
+lat_forma* lat_forma_vacia()
 {
-    if (ns->tipo != T_INSTANCE)
+    lat_forma* f = (lat_forma*)lat_asignar_memoria(sizeof(lat_forma));
+    f->version = HASH_VERSION_VACIA;
+    f->padre = NULL;
+    f->nombre = NULL;
+    f->num_atributos = 0;
+    f->transiciones = NULL;
+    return f;
+}
+
+void lat_forma_destruir(lat_forma* f)
+{
+    if (f->transiciones != NULL)
+    {
+        size_t i;
+        for (i = 0; i < f->transiciones->capacidad; i++)
+        {
+            if (f->transiciones->entradas[i].key != NULL)
+            {
+                lat_forma_destruir((lat_forma*)f->transiciones->entradas[i].val);
+            }
+        }
+        free_hash(f->transiciones);
+    }
+    lat_liberar_memoria(f);
+}
+
+/* forma que resulta de agregar el atributo nombre a la forma f */
+static lat_forma* lat_forma_transicion(lat_forma* f, lat_objeto* nombre)
+{
+    lat_forma* hija;
+    if (f->transiciones == NULL)
+    {
+        f->transiciones = make_hash_map();
+    }
+    hija = (lat_forma*)get_hash(f->transiciones, nombre);
+    if (hija == NULL)
+    {
+        hija = (lat_forma*)lat_asignar_memoria(sizeof(lat_forma));
+        hija->version = hash_nueva_version();
+        hija->padre = f;
+        /* el recolector no recorre las formas: guardan el nombre internado,
+           que nunca se libera */
+        hija->nombre = lat_cadena_internar(lat_obtener_cadena(nombre), lat_cadena_longitud(nombre));
+        hija->num_atributos = f->num_atributos + 1;
+        hija->transiciones = NULL;
+        set_hash(f->transiciones, hija->nombre, (void*)hija);
+    }
+    return hija;
+}
+
+/* la instancia deja de compartir la forma: los nombres pasan a una tabla
+   propia con la posicion de cada valor */
+static void lat_instancia_a_diccionario(lat_atributos* a)
+{
+    lat_forma* f;
+    a->diccionario = make_hash_map();
+    for (f = a->forma; f->padre != NULL; f = f->padre)
+    {
+        set_hash(a->diccionario, f->nombre, (void*)(intptr_t)f->num_atributos);
+    }
+    a->forma = NULL;
+}
+
+int lat_instancia_buscar(lat_objeto* ins, lat_objeto* nombre)
+{
+    lat_atributos* a = ins->datos.atributos;
+    lat_forma* f;
+    if (a->forma == NULL)
+    {
+        return (int)(intptr_t)get_hash(a->diccionario, nombre) - 1;
+    }
+    for (f = a->forma; f->padre != NULL; f = f->padre)
+    {
+        if (lat_cadenas_iguales(f->nombre, nombre))
+        {
+            return f->num_atributos - 1;
+        }
+    }
+    return -1;
+}
+
+int lat_instancia_asignar(lat_mv *mv, lat_objeto* ins, lat_objeto* nombre, lat_objeto* valor)
+{
+    lat_atributos* a = ins->datos.atributos;
+    int posicion = lat_instancia_buscar(ins, nombre);
+    if (posicion >= 0)
     {
-        debug("ns->type: %d", ns->tipo);
+        a->valores[posicion] = valor;
+        return posicion;
+    }
+    if (a->num_valores == a->capacidad)
+    {
+        int capacidad = a->capacidad == 0 ? 4 : a->capacidad * 2;
+        mv->memoria_usada += sizeof(lat_objeto*) * (size_t)(capacidad - a->capacidad);
+        a->capacidad = capacidad;
+        a->valores = (lat_objeto**)lat_reasignar_memoria(a->valores, sizeof(lat_objeto*) * a->capacidad);
+    }
+    posicion = a->num_valores++;
+    a->valores[posicion] = valor;
+    if (a->forma != NULL && a->num_valores > MAX_ATRIBUTOS_FORMA)
+    {
+        lat_instancia_a_diccionario(a);
+    }
+    if (a->forma == NULL)
+    {
+        set_hash(a->diccionario, nombre, (void*)(intptr_t)(posicion + 1));
+        a->version = a->diccionario->version;
+    }
+    else
+    {
+        a->forma = lat_forma_transicion(a->forma, nombre);
+        a->version = a->forma->version;
+    }
+    return posicion;
+}
+
+void lat_instancia_limpiar(lat_mv *mv, lat_objeto* ins)
+{
+    lat_atributos* a = ins->datos.atributos;
+    if (a->forma == NULL)
+    {
+        free_hash(a->diccionario);
+        a->diccionario = NULL;
+    }
+    a->forma = mv->forma_vacia;
+    a->version = mv->forma_vacia->version;
+    a->num_valores = 0;
+}
+
+void lat_instancia_liberar(lat_mv *mv, lat_objeto* ins)
+{
+    lat_atributos* a = ins->datos.atributos;
+    mv->memoria_usada -= sizeof(lat_objeto) + lat_atributos_memoria(a);
+    if (a->forma == NULL)
+    {
+        free_hash(a->diccionario);
+    }
+    lat_liberar_memoria(a->valores);
+    lat_liberar_memoria(a);
+    lat_slab_devolver(ins);
+}
+
+void lat_asignar_contexto_objeto(lat_mv *mv, lat_objeto* ns, lat_objeto* name, lat_objeto* o)
+{
+    if (lat_tipo(ns) != T_INSTANCE)
+    {
+        debug("ns->type: %d", lat_tipo(ns));
         lat_registrar_error("Namespace no es una instancia");
     }
     else
     {
-        hash_map* h = ns->datos.nombre;
-        set_hash(h, lat_obtener_cadena(name), (void*)o);
+        lat_instancia_asignar(mv, ns, name, o);
     }
 }
 
 lat_objeto* lat_obtener_contexto_objeto(lat_objeto* ns, lat_objeto* name)
 {
-    if (ns->tipo != T_INSTANCE)
+    if (lat_tipo(ns) != T_INSTANCE)
     {
-        debug("ns->type: %d", ns->tipo);
+        debug("ns->type: %d", lat_tipo(ns));
         lat_registrar_error("Namespace is not an nombre");
     }
     else
     {
-        hash_map* h = ns->datos.nombre;
-        lat_objeto* ret = (lat_objeto*)get_hash(h, lat_obtener_cadena(name));
-        if (ret == NULL)
+        int posicion = lat_instancia_buscar(ns, name);
+        if (posicion < 0)
         {
             lat_registrar_error("Variable \"%s\" indefinida", lat_obtener_cadena(name));
+            return NULL;
         }
-        return ret;
+        return lat_instancia_valor(ns, posicion);
     }
     return NULL;
 }
 
 int lat_contexto_contiene(lat_objeto* ns, lat_objeto* name)
 {
-    if (ns->tipo != T_INSTANCE)
+    if (lat_tipo(ns) != T_INSTANCE)
     {
-        debug("ns->type: %d", ns->tipo);
+        debug("ns->type: %d", lat_tipo(ns));
         lat_registrar_error("Namespace no es una instancia");
     }
     else
     {
-        hash_map* h = ns->datos.nombre;
-        lat_objeto* ret = (lat_objeto*)get_hash(h, lat_obtener_cadena(name));
-        if (ret == NULL)
-        {
-            return 0;
-        }
-        return 1;
+        return lat_instancia_buscar(ns, name) >= 0;
     }
     return 0;
 }
 
 lat_objeto* lat_crear_objeto(lat_mv *mv)
 {
-    lat_objeto* ret = (lat_objeto*)lat_asignar_memoria(sizeof(lat_objeto));
+    lat_objeto* ret = (lat_objeto*)lat_slab_asignar(&mv->objetos);
+    mv->memoria_usada += sizeof(lat_objeto);
     ret->tipo = T_NULO;
+    ret->marcado = 0;
+    ret->inmortal = false;
+    ret->es_constante = false;
+    ret->num_declarado = 0;
     ret->tamanio_datos = 0;
+    ret->hash = 0;
     return ret;
 }
 
@@ -99,8 +245,26 @@ lat_objeto* lat_instancia(lat_mv *mv)
 {
     lat_objeto* ret = lat_crear_objeto(mv);
     ret->tipo = T_INSTANCE;
-    ret->tamanio_datos = sizeof(hash_map*);
-    ret->datos.nombre = make_hash_map();
+    ret->tamanio_datos = sizeof(lat_atributos*);
+    ret->datos.atributos = (lat_atributos*)lat_asignar_memoria(sizeof(lat_atributos));
+    ret->datos.atributos->forma = mv->forma_vacia;
+    ret->datos.atributos->diccionario = NULL;
+    ret->datos.atributos->version = mv->forma_vacia->version;
+    ret->datos.atributos->valores = NULL;
+    ret->datos.atributos->num_valores = 0;
+    ret->datos.atributos->capacidad = 0;
+    ret->datos.atributos->padre = NULL;
+    ret->datos.atributos->capturado = false;
+    mv->memoria_usada += lat_atributos_memoria(ret->datos.atributos);
+    return ret;
+}
+
+lat_objeto* lat_diccionario_nuevo(lat_mv *mv)
+{
+    lat_objeto* ret = lat_crear_objeto(mv);
+    ret->tipo = T_DICT;
+    ret->tamanio_datos = sizeof(lat_diccionario*);
+    ret->datos.diccionario = lat_diccionario_crear(mv);
     return ret;
 }
 
@@ -115,16 +279,30 @@ lat_objeto* lat_logico_nuevo(lat_mv *mv, bool val)
 
 lat_objeto* lat_entero_nuevo(lat_mv *mv, long val)
 {
-    lat_objeto* ret = lat_crear_objeto(mv);
+    lat_objeto* ret;
+    if (val >= LAT_ENTERO_ETIQUETADO_MIN && val <= LAT_ENTERO_ETIQUETADO_MAX)
+    {
+        return lat_entero_etiquetado(val);
+    }
+    ret = lat_crear_objeto(mv);
     ret->tipo = T_INT;
     ret->tamanio_datos = sizeof(long);
     ret->datos.entero = val;
     return ret;
 }
 
+lat_objeto* lat_decimal_nuevo(lat_mv *mv, double val)
+{
+    lat_objeto* ret = lat_crear_objeto(mv);
+    ret->tipo = T_DOUBLE;
+    ret->tamanio_datos = sizeof(double);
+    ret->datos.decimal = val;
+    return ret;
+}
+
 lat_objeto* lat_cadena_nueva(lat_mv *mv, const char* p)
 {
-    lat_objeto* ret = lat_cadena_hash(p, strlen(p));
+    lat_objeto* ret = lat_cadena_hash(mv, p, strlen(p));
     return ret;
 }
 
@@ -133,6 +311,7 @@ lat_objeto* lat_funcion_nueva(lat_mv *mv)
     lat_objeto* ret = lat_crear_objeto(mv);
     ret->tipo = T_FUNC;
     ret->tamanio_datos = 0;
+    ret->datos.alcance = NULL;
     return ret; //We don't do anything here: all bytecode will be added later
 }
 
@@ -145,7 +324,11 @@ lat_objeto* lat_cfuncion_nueva(lat_mv *mv)
 
 void lat_eliminar_objeto(lat_mv *mv, lat_objeto* o)
 {
-    switch (o->tipo)
+    if (lat_es_inmortal(o))
+    {
+        return;
+    }
+    switch (lat_tipo(o))
     {
     case T_NULO:
         return;
@@ -157,7 +340,8 @@ void lat_eliminar_objeto(lat_mv *mv, lat_objeto* o)
         //lat_eliminar_lista(mv, o->data.lista);
         break;
     case T_DICT:
-        //lat_eliminar_lista(mv, o->data.lista);
+        mv->memoria_usada -= lat_diccionario_memoria(o->datos.diccionario);
+        lat_diccionario_liberar(o->datos.diccionario);
         break;
     case T_LIT:
     case T_INT:
@@ -176,7 +360,9 @@ void lat_eliminar_objeto(lat_mv *mv, lat_objeto* o)
         return;
         break;
     }
-    lat_liberar_memoria(o);
+    /* la celda se cargo a la memoria usada en lat_crear_objeto */
+    mv->memoria_usada -= sizeof(lat_objeto);
+    lat_slab_devolver(o);
 }
 
 void lat_eliminar_lista(lat_mv *mv, list_node* l)
@@ -198,45 +384,57 @@ void lat_eliminar_lista(lat_mv *mv, list_node* l)
 
 void lat_eliminar_hash(lat_mv *mv, hash_map* h)
 {
-    int c = 0;
-    list_node* l;
-    list_node* cur;
-    hash_val* hv;
-    for (c = 0; c < 256; ++c)
+    size_t i;
+    for (i = 0; i < h->capacidad; i++)
     {
-        l = h->buckets[c];
-        if (l != NULL)
+        if (h->entradas[i].key != NULL)
         {
-            for (cur = l->next; cur != NULL; cur = cur->next)
-            {
-                if (cur != NULL)
-                {
-                    if (cur->data != NULL)
-                    {
-                        hv = (hash_val*)cur->data;
-                        lat_eliminar_objeto(mv, (lat_objeto*)hv->val);
-                        lat_liberar_memoria(hv);
-                    }
-                    //lat_liberar_memoria(cur);
-                }
-            }
-            lat_liberar_memoria(l);
+            lat_eliminar_objeto(mv, (lat_objeto*)h->entradas[i].val);
         }
     }
+    lat_liberar_memoria(h->entradas);
+    h->entradas = NULL;
+    h->capacidad = 0;
+    h->num_llaves = 0;
+    h->version = HASH_VERSION_VACIA;
 }
 
 lat_objeto* lat_clonar_objeto(lat_mv *mv, lat_objeto* obj)
 {
     lat_objeto* ret;
-    switch (obj->tipo)
+    if (lat_es_inmortal(obj))
+    {
+        return obj;
+    }
+    switch (lat_tipo(obj))
     {
     case T_INSTANCE:
+        {
+            /* la copia comparte la forma (o copia el diccionario) y clona los valores */
+            lat_atributos* a = obj->datos.atributos;
+            lat_atributos* c;
+            int i;
+            ret = lat_instancia(mv);
+            c = ret->datos.atributos;
+            c->forma = a->forma;
+            c->diccionario = a->forma == NULL ? copy_hash(a->diccionario) : NULL;
+            c->version = a->forma == NULL ? c->diccionario->version : a->version;
+            c->capacidad = a->num_valores + 1;
+            c->num_valores = a->num_valores;
+            c->valores = (lat_objeto**)lat_asignar_memoria(sizeof(lat_objeto*) * c->capacidad);
+            mv->memoria_usada += sizeof(lat_objeto*) * (size_t)c->capacidad;
+            for (i = 0; i < a->num_valores; i++)
+            {
+                c->valores[i] = lat_clonar_objeto(mv, a->valores[i]);
+            }
+        }
+        break;
+    case T_DICT:
         ret = lat_crear_objeto(mv);
-        ret->tipo = T_INSTANCE;
-        ret->tamanio_datos = sizeof(hash_map*);
-        ret->datos.nombre = lat_clonar_hash(mv, obj->datos.nombre);
-        //ret->data.nombre = obj->data.nombre;
-        break;    
+        ret->tipo = T_DICT;
+        ret->tamanio_datos = sizeof(lat_diccionario*);
+        ret->datos.diccionario = lat_diccionario_copiar(mv, obj->datos.diccionario);
+        break;
     case T_FUNC:
     case T_CFUNC:
         ret = obj;
@@ -245,7 +443,11 @@ lat_objeto* lat_clonar_objeto(lat_mv *mv, lat_objeto* obj)
         ret = lat_crear_objeto(mv);
         ret->tipo = obj->tipo;
         ret->marcado = obj->marcado;
+        ret->inmortal = false;
+        ret->es_constante = obj->es_constante;
+        ret->num_declarado = obj->num_declarado;
         ret->tamanio_datos = obj->tamanio_datos;
+        ret->hash = obj->hash;
         ret->datos = obj->datos;
         break;
     }
@@ -271,42 +473,174 @@ list_node* lat_clonar_lista(lat_mv *mv, list_node* l)
 
 hash_map* lat_clonar_hash(lat_mv *mv, hash_map* h)
 {
-    int c = 0;
-    hash_map* ret = make_hash_map();
-    list_node* l;
-    for (c = 0; c < 256; ++c)
+    /* las llaves quedan en las mismas posiciones, solo se clonan los valores */
+    hash_map* ret = copy_hash(h);
+    size_t i;
+    for (i = 0; i < ret->capacidad; i++)
+    {
+        if (ret->entradas[i].key != NULL)
+        {
+            ret->entradas[i].val = lat_clonar_objeto(mv, (lat_objeto*)ret->entradas[i].val);
+        }
+    }
+    return ret;
+}
+
+void lat_marcar_objeto(lat_mv *mv, lat_objeto* o)
+{
+    if (o == NULL || lat_es_inmortal(o) || o->marcado)
+    {
+        return;
+    }
+    o->marcado = 1;
+    if (mv->num_grises == mv->tamanio_grises)
+    {
+        mv->tamanio_grises = mv->tamanio_grises == 0 ? 256 : mv->tamanio_grises * 2;
+        mv->grises = (lat_objeto**)lat_reasignar_memoria(mv->grises, sizeof(lat_objeto*) * mv->tamanio_grises);
+    }
+    mv->grises[mv->num_grises++] = o;
+}
+
+void lat_marcar_lista(lat_mv *mv, list_node* l)
+{
+    list_node* c;
+    if (l == NULL)
+    {
+        return;
+    }
+    for (c = l->next; c != NULL; c = c->next)
+    {
+        lat_marcar_objeto(mv, (lat_objeto*)c->data);
+    }
+}
+
+void lat_marcar_hash(lat_mv *mv, hash_map* h)
+{
+    size_t i;
+    for (i = 0; i < h->capacidad; i++)
+    {
+        if (h->entradas[i].key != NULL)
+        {
+            lat_marcar_objeto(mv, (lat_objeto*)h->entradas[i].key);
+        }
+    }
+}
+
+void lat_marcar_grises(lat_mv *mv)
+{
+    /* pila explicita: las estructuras muy anidadas no agotan la pila de C */
+    while (mv->num_grises > 0)
     {
-        l = h->buckets[c];
-        if (l != NULL)
+        lat_objeto* o = mv->grises[--mv->num_grises];
+        size_t i;
+        switch (o->tipo)
+        {
+        case T_INSTANCE:
         {
-            ret->buckets[c] = lat_crear_lista();
-            if (l != NULL)
+            lat_atributos* a = o->datos.atributos;
+            for (i = 0; i < (size_t)a->num_valores; i++)
             {
-                list_node* cur;
-                for (cur = l->next; cur != NULL; cur = cur->next)
+                lat_marcar_objeto(mv, a->valores[i]);
+            }
+            if (a->forma == NULL)
+            {
+                lat_marcar_hash(mv, a->diccionario);
+            }
+            lat_marcar_objeto(mv, a->padre);
+        }
+        break;
+        case T_DICT:
+        {
+            lat_diccionario* d = o->datos.diccionario;
+            for (i = 0; i < d->capacidad; i++)
+            {
+                if (d->control[i] != LAT_DIC_VACIO)
                 {
-                    if (cur->data != NULL)
-                    {
-                        hash_val* hv = (hash_val*)lat_asignar_memoria(sizeof(hash_val));
-                        //mv->memoria_usada += sizeof(hash_val);
-                        strncpy(hv->key, ((hash_val*)cur->data)->key, 256);
-                        hv->val = lat_clonar_objeto(mv, (lat_objeto*)((hash_val*)cur->data)->val);
-                        insert_list(ret->buckets[c], hv);
-                    }
+                    lat_marcar_objeto(mv, d->entradas[i].llave);
+                    lat_marcar_objeto(mv, d->entradas[i].valor);
                 }
             }
         }
+        break;
+        case T_FUNC:
+        {
+            lat_funcion* fun = (lat_funcion*)o->datos.funcion;
+            for (i = 0; i < (size_t)fun->num_constantes; i++)
+            {
+                lat_marcar_objeto(mv, fun->constantes[i]);
+            }
+            lat_marcar_objeto(mv, o->datos.alcance);
+        }
+        break;
+        case T_LIST:
+            lat_marcar_lista(mv, o->datos.lista);
+            break;
+        default:
+            break;
+        }
     }
-    return ret;
+}
+
+bool lat_barrer_objeto(void* celda, void* dato)
+{
+    lat_objeto* o = (lat_objeto*)celda;
+    lat_mv* mv = (lat_mv*)dato;
+    if (o->inmortal || o->marcado)
+    {
+        o->marcado = 0;
+        mv->memoria_usada += sizeof(lat_objeto);
+        if (o->tipo == T_STR)
+        {
+            mv->memoria_usada += lat_cadena_longitud(o) + 1;
+        }
+        else if (o->tipo == T_INSTANCE)
+        {
+            mv->memoria_usada += lat_atributos_memoria(o->datos.atributos);
+        }
+        else if (o->tipo == T_DICT)
+        {
+            mv->memoria_usada += lat_diccionario_memoria(o->datos.diccionario);
+        }
+        return false;
+    }
+    switch (o->tipo)
+    {
+    case T_INSTANCE:
+    {
+        lat_atributos* a = o->datos.atributos;
+        if (a->forma == NULL)
+        {
+            free_hash(a->diccionario);
+        }
+        lat_liberar_memoria(a->valores);
+        lat_liberar_memoria(a);
+    }
+    break;
+    case T_DICT:
+        lat_diccionario_liberar(o->datos.diccionario);
+        break;
+    case T_STR:
+        /* las cadenas internadas son inmortales, esta es una copia propia */
+        lat_liberar_memoria(o->datos.cadena);
+        break;
+    default:
+        /* las funciones (lat_funcion) se comparten con las constantes */
+        break;
+    }
+    return true;
 }
 
 long lat_obtener_entero(lat_objeto* o)
 {
-    if (o->tipo == T_INT)
+    if (lat_es_etiquetado(o))
+    {
+        return lat_valor_etiquetado(o);
+    }
+    if (lat_tipo(o) == T_INT)
     {
         return o->datos.entero;
     }
-    if (o->tipo == T_DOUBLE)
+    if (lat_tipo(o) == T_DOUBLE)
     {
         return (long)o->datos.decimal;
     }
@@ -314,9 +648,23 @@ long lat_obtener_entero(lat_objeto* o)
     return 0;
 }
 
+double lat_obtener_decimal(lat_objeto* o)
+{
+    if (lat_tipo(o) == T_DOUBLE)
+    {
+        return o->datos.decimal;
+    }
+    if (lat_tipo(o) == T_INT)
+    {
+        return (double)lat_obtener_entero(o);
+    }
+    lat_registrar_error("Object no es un tipo decimal");
+    return 0;
+}
+
 char* lat_obtener_cadena(lat_objeto* o)
 {
-    if (o->tipo == T_STR)
+    if (lat_tipo(o) == T_STR)
     {
         return o->datos.cadena;
     }
@@ -326,13 +674,13 @@ char* lat_obtener_cadena(lat_objeto* o)
 
 bool lat_obtener_logico(lat_objeto* o)
 {
-    if (o->tipo == T_BOOL)
+    if (lat_tipo(o) == T_BOOL)
     {
         return o->datos.logico;
     }
-    if (o->tipo == T_INT)
+    if (lat_tipo(o) == T_INT)
     {
-        return o->datos.entero;
+        return lat_obtener_entero(o) != 0;
     }
     lat_registrar_error("Object no es un tipo logico");
     return false;
@@ -27,6 +27,8 @@ THE SOFTWARE.
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
 
 typedef struct lat_objeto lat_objeto;
 
@@ -62,21 +64,76 @@ typedef enum lat_tipo_objeto
     T_STRUCT,       /**< estructura */
 } lat_tipo_objeto;
 
+/** \brief Forma (clase oculta) de una instancia
+*
+* Las instancias a las que se agregan los mismos atributos en el mismo orden
+* comparten la forma. Cada forma agrega un atributo a su padre y guarda las
+* transiciones a las formas que resultan de agregarle otro; el valor de un
+* atributo esta en la misma posicion en todas las instancias de la forma.
+*/
+typedef struct lat_forma
+{
+    unsigned long version;          /**< Identificador unico de la forma */
+    struct lat_forma* padre;        /**< Forma sin el ultimo atributo, NULL en la forma vacia */
+    lat_objeto* nombre;             /**< Ultimo atributo agregado */
+    int num_atributos;              /**< Numero de atributos (el ultimo esta en num_atributos - 1) */
+    hash_map* transiciones;         /**< nombre del atributo -> forma hija */
+} lat_forma;
+
+/** \brief Atributos de una instancia
+*
+* Los valores se guardan en un arreglo en el orden de la forma. Si se agregan
+* mas de MAX_ATRIBUTOS_FORMA la instancia pasa a modo diccionario: cada
+* instancia tiene su propia tabla con la posicion de cada atributo.
+*/
+typedef struct lat_atributos
+{
+    lat_forma* forma;           /**< Forma de la instancia, NULL en modo diccionario */
+    hash_map* diccionario;      /**< nombre del atributo -> posicion + 1 (modo diccionario) */
+    unsigned long version;      /**< Version de la forma o del diccionario, cambia al agregar un atributo */
+    lat_objeto** valores;       /**< Valores de los atributos */
+    int num_valores;            /**< Numero de atributos */
+    int capacidad;              /**< Numero de valores reservados */
+    lat_objeto* padre;          /**< Contexto de la funcion que encierra a la del contexto, NULL si no es un contexto o lo encierra el global */
+    bool capturado;             /**< Una funcion definida en el contexto lo guarda como su alcance, no se libera al regresar */
+} lat_atributos;
+
+/** \brief Crea la forma sin atributos, raiz de las transiciones de una MV
+  *
+  * \return lat_forma: Forma vacia
+  */
+lat_forma* lat_forma_vacia();
+
+/** \brief Libera una forma y todas las que resultan de ella
+  *
+  * \param f: Forma
+  */
+void lat_forma_destruir(lat_forma* f);
+
+/** \brief Memoria que reservan los atributos de una instancia (sin la tabla del modo diccionario) */
+#define lat_atributos_memoria(a) (sizeof(lat_atributos) + sizeof(lat_objeto*) * (size_t)(a)->capacidad)
+
+struct lat_diccionario;
+
 /** \brief Datos del objeto
 *
 * Almacena la informacion del objeto
 */
 typedef union lat_datos_objeto
 {
-    hash_map* nombre;       /**< nombre del objeto */
+    lat_atributos* atributos;   /**< atributos de la instancia */
     char* literal;          /**< valor literal */
     long entero;            /**< valor entero */
     double decimal;         /**< valor decimal */
     char* cadena;           /**< valor cadena */
     bool logico;            /**< valor logico */
     list_node* lista;       /**< valor de la lista */
-    hash_map* diccionario;  /**< valor del diccionario */
-    void* funcion;          /**< valor funcion */
+    struct lat_diccionario* diccionario;    /**< valor del diccionario */
+    struct
+    {
+        void* funcion;      /**< valor funcion */
+        lat_objeto* alcance;    /**< Contexto donde se definio la funcion (funcion de usuario) */
+    };
     void (*cfunc)(lat_mv*); /**< valor funcion C */
     void* cstruct;          /**< valor estructura */
 } lat_datos_objeto;
@@ -91,12 +148,45 @@ struct lat_objeto
 {
     lat_tipo_objeto tipo;   /**< Tipo de objeto */
     int marcado;            /**< para marcar el objeto Colector de basura */
-    size_t tamanio_datos;   /**< Tamanio de la informacion */
+    bool inmortal;          /**< Objeto compartido que nunca se clona ni se libera */
+    size_t tamanio_datos;   /**< Tamanio de la informacion (longitud en bytes de una cadena) */
     bool es_constante;      /**< Valida si es una constante */
     int num_declarado;      /**< Numero de veces declarado */
+    unsigned int hash;      /**< Hash de la cadena (T_STR), se calcula al crearla */
     lat_datos_objeto datos; /**< Informacion del objeto */
 };
 
+/** \brief Enteros etiquetados
+*
+* Los objetos estan alineados, asi que un apuntador a objeto nunca tiene el bit
+* bajo en 1. Un entero que cabe en los bits restantes se guarda en el propio
+* apuntador (valor << 1 | 1) sin reservar memoria; lat_entero_nuevo solo crea
+* un objeto T_INT para los que no caben. nulo, verdadero y falso son objetos
+* unicos de la MV. Antes de leer el tipo o los datos de un valor que puede ser
+* entero se usa lat_tipo / lat_obtener_entero.
+*/
+#define lat_es_etiquetado(o) (((uintptr_t)(o)) & 1)
+
+/** \brief Ambos valores son enteros etiquetados */
+#define lat_ambos_etiquetados(a, b) (((uintptr_t)(a)) & ((uintptr_t)(b)) & 1)
+
+/** \brief Entero etiquetado con el valor n (debe estar entre LAT_ENTERO_ETIQUETADO_MIN y MAX) */
+#define lat_entero_etiquetado(n) ((lat_objeto*)((((uintptr_t)(n)) << 1) | 1))
+
+/** \brief Valor de un entero etiquetado */
+#define lat_valor_etiquetado(o) ((long)(((intptr_t)(o)) >> 1))
+
+/** \brief Rango de los enteros etiquetados */
+#define LAT_ENTERO_ETIQUETADO_MAX (LONG_MAX >> 1)
+#define LAT_ENTERO_ETIQUETADO_MIN (LONG_MIN >> 1)
+
+/** \brief El valor nunca se clona ni se libera: enteros etiquetados, nulo,
+* verdadero, falso, cadenas internadas y constantes enteras */
+#define lat_es_inmortal(o) (lat_es_etiquetado(o) || (o)->inmortal)
+
+/** \brief Tipo de un valor (objeto o entero etiquetado) */
+#define lat_tipo(o) (lat_es_etiquetado(o) ? T_INT : (o)->tipo)
+
 struct lat_llave_valor
 {
     lat_tipo_objeto tipo;   /**< Tipo de objeto */
@@ -106,11 +196,12 @@ struct lat_llave_valor
 
 /** \brief Asigna el objeto a un contexto (local / publico)
   *
+  * \param mv: Maquina virtual
   * \param ns: Contexto en el que se encuentra el objeto
   * \param name: Nombre del objeto
   * \param o: objeto a asignado
   */
-void lat_asignar_contexto_objeto(lat_objeto* ns, lat_objeto* name, lat_objeto* o);
+void lat_asignar_contexto_objeto(lat_mv *mv, lat_objeto* ns, lat_objeto* name, lat_objeto* o);
 
 /** \brief Obtiene un objeto de un contexto  (local / publico)
   *
@@ -140,6 +231,59 @@ lat_objeto* lat_crear_objeto(lat_mv *mv);
   */
 lat_objeto* lat_instancia(lat_mv *mv);
 
+/** \brief Busca la posicion de un atributo de una instancia
+  *
+  * La posicion no cambia mientras no cambie la version de la instancia, por
+  * lo que un cache puede guardarla junto con la version.
+  *
+  * \param ins: Instancia
+  * \param nombre: Nombre del atributo
+  * \return int: Posicion del valor o -1 si no existe
+  */
+int lat_instancia_buscar(lat_objeto* ins, lat_objeto* nombre);
+
+/** \brief Asigna un atributo de una instancia, lo agrega si no existe; si
+  * crece el arreglo de valores la memoria nueva se suma a la de la MV
+  *
+  * \param mv: Maquina virtual
+  * \param ins: Instancia
+  * \param nombre: Nombre del atributo
+  * \param valor: Valor del atributo
+  * \return int: Posicion del valor
+  */
+int lat_instancia_asignar(lat_mv *mv, lat_objeto* ins, lat_objeto* nombre, lat_objeto* valor);
+
+/** \brief Elimina todos los atributos de una instancia sin liberar los valores
+  *
+  * \param mv: Maquina virtual
+  * \param ins: Instancia
+  */
+void lat_instancia_limpiar(lat_mv *mv, lat_objeto* ins);
+
+/** \brief Libera una instancia sin liberar los valores de sus atributos y
+  * descuenta su memoria de la MV
+  *
+  * \param mv: Maquina virtual
+  * \param ins: Instancia
+  */
+void lat_instancia_liberar(lat_mv *mv, lat_objeto* ins);
+
+/** \brief Valor del atributo que esta en una posicion de la instancia */
+#define lat_instancia_valor(ins, posicion) ((ins)->datos.atributos->valores[(posicion)])
+
+/** \brief Contexto que encierra al contexto (ver lat_atributos) */
+#define lat_instancia_padre(ins) ((ins)->datos.atributos->padre)
+
+/** \brief Version de la instancia (ver lat_atributos) */
+#define lat_instancia_version(ins) ((ins)->datos.atributos->version)
+
+/** \brief Crea un objeto diccionario vacio
+  *
+  * \param vm: Intancia de la maquina virtual
+  * \return lat_objeto: Apuntador al objeto creado
+  */
+lat_objeto* lat_diccionario_nuevo(lat_mv *mv);
+
 /** \brief Crea un objeto logico
   *
   * \param vm: Intancia de la maquina virtual
@@ -202,26 +346,44 @@ lat_objeto* lat_funcion_nueva(lat_mv *mv);
   */
 lat_objeto* lat_cfuncion_nueva(lat_mv *mv);
 
-/** \brief Marca un objeto para el colector de basura
+/** \brief Marca un objeto alcanzable para el colector de basura; sus
+  * referencias se marcan despues con lat_marcar_grises. Los enteros
+  * etiquetados y los objetos inmortales no se marcan
   *
+  * \param vm: Intancia de la maquina virtual
   * \param o: Apuntador al objeto
-  * \param m: valor de la marca
   */
-void lat_marcar_objeto(lat_objeto* o, int m);
+void lat_marcar_objeto(lat_mv *mv, lat_objeto* o);
 
-/** \brief Marca una lista de objetos para el colector de basura
+/** \brief Marca los objetos de una lista para el colector de basura
   *
+  * \param vm: Intancia de la maquina virtual
   * \param l: Apuntador al nodo de la lista
-  * \param m: valor de la marca
   */
-void lat_marcar_lista(list_node* l, unsigned char m);
+void lat_marcar_lista(lat_mv *mv, list_node* l);
 
-/** \brief Marca una tabla hash de objetos para el colector de basura
+/** \brief Marca las llaves (nombres) de una tabla hash para el colector de basura
   *
-  * \param l: Apuntador al nodo de la tabla hash
-  * \param m: valor de la marca
+  * \param vm: Intancia de la maquina virtual
+  * \param h: Apuntador a la tabla hash
+  */
+void lat_marcar_hash(lat_mv *mv, hash_map* h);
+
+/** \brief Marca las referencias de los objetos marcados hasta que no queda
+  * ninguno pendiente
+  *
+  * \param vm: Intancia de la maquina virtual
+  */
+void lat_marcar_grises(lat_mv *mv);
+
+/** \brief Barrido del colector de basura (ver lat_slab_barrer): libera el
+  * objeto de la celda si no esta marcado y quita la marca a los demas
+  *
+  * \param celda: Objeto de la celda
+  * \param mv: Intancia de la maquina virtual
+  * \return bool: verdadero si la celda se debe devolver al slab
   */
-void lat_marcar_hash(hash_map* l, unsigned char m);
+bool lat_barrer_objeto(void* celda, void* mv);
 
 /** \brief Elimina un objeto de la lista de objetos creados dinamicamente
   *
@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.2.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2013 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_YY_PARSE_H_INCLUDED
 # define YY_YY_PARSE_H_INCLUDED
 /* Debug traces.  */
@@ -40,20 +45,47 @@
 extern int yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    TINT = 258,
-    TSTRING = 259,
-    TIDENTIFIER = 260,
-    KIF = 261,
-    KEND = 262,
-    KELSE = 263,
-    OP_EQ = 264
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    TINT = 258,                    /* TINT  */
+    TSTRING = 259,                 /* TSTRING  */
+    TIDENTIFIER = 260,             /* TIDENTIFIER  */
+    KIF = 261,                     /* KIF  */
+    KEND = 262,                    /* KEND  */
+    KELSE = 263,                   /* KELSE  */
+    KFUNCTION = 264,               /* KFUNCTION  */
+    KRETURN = 265,                 /* KRETURN  */
+    OP_EQ = 266,                   /* OP_EQ  */
+    OP_NEQ = 267,                  /* OP_NEQ  */
+    OP_LE = 268,                   /* OP_LE  */
+    OP_GE = 269                    /* OP_GE  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
+#define TINT 258
+#define TSTRING 259
+#define TIDENTIFIER 260
+#define KIF 261
+#define KEND 262
+#define KELSE 263
+#define KFUNCTION 264
+#define KRETURN 265
+#define OP_EQ 266
+#define OP_NEQ 267
+#define OP_LE 268
+#define OP_GE 269
 
 /* Value type.  */
 
@@ -73,6 +105,8 @@ struct YYLTYPE
 
 
 
+
 int yyparse (ast **root, void *scanner);
 
+
 #endif /* !YY_YY_PARSE_H_INCLUDED  */
@@ -16,6 +16,9 @@
 #define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #endif
 
+/* los nodos se crean en la arena del analisis */
+#define ARENA (yyget_extra(scanner)->arena)
+
 int yyerror(struct YYLTYPE *yylloc_param, void *scanner, struct ast **root, const char *s);
 int yylex (YYSTYPE * yylval_param,YYLTYPE * yylloc_param ,yyscan_t yyscanner);
 
@@ -38,26 +41,40 @@ int yylex (YYSTYPE * yylval_param,YYLTYPE * yylloc_param ,yyscan_t yyscanner);
     KIF
     KEND
     KELSE
+    KFUNCTION
+    KRETURN
 
 %token
     OP_EQ
+    OP_NEQ
+    OP_LE
+    OP_GE
 
 %type <node> program statement_list
 %type <node> declaration
-%type <node> equality_expression expression constant_expression
+%type <node> equality_expression relational_expression
+%type <node> additive_expression multiplicative_expression
+%type <node> expression constant_expression
 %type <node> statement function_call argument_expression_list
 %type <node> primary_expression
 %type <node> selection_statement
+%type <node> function_definition parameter_list jump_statement
+%type <node> dictionary_expression dictionary_items dictionary_item subscript_expression
 
 /*
  * precedencia de operadores
  * 0: -
- * 1: * /
+ * 1: * / %
  * 2: + -
+ * 3: < <= > >=
+ * 4: == !=
  *
  */
 %right '='
-%left OP_EQ
+%left OP_EQ OP_NEQ
+%left '<' OP_LE '>' OP_GE
+%left '+' '-'
+%left '*' '/' '%'
 
 %start program
 
@@ -66,6 +83,8 @@ int yylex (YYSTYPE * yylval_param,YYLTYPE * yylloc_param ,yyscan_t yyscanner);
 primary_expression:
       TIDENTIFIER { $$ = $1; }
     | constant_expression  { $$ = $1; }
+    | dictionary_expression { $$ = $1; }
+    | subscript_expression { $$ = $1; }
     ;
 
 constant_expression:
@@ -73,8 +92,44 @@ constant_expression:
     | TSTRING { $$ = $1; }
     ;
 
+dictionary_expression:
+      '{' dictionary_items '}' { $$ = nodo_nuevo(ARENA, NODO_DICCIONARIO, $2, NULL); }
+    ;
+
+dictionary_items: /* empty */ { $$ = NULL; }
+    | dictionary_item { $$ = nodo_nuevo(ARENA, NODO_DICCIONARIO_ELEMENTOS, $1, NULL); }
+    | dictionary_item ',' dictionary_items { $$ = nodo_nuevo(ARENA, NODO_DICCIONARIO_ELEMENTOS, $1, $3); }
+    ;
+
+dictionary_item:
+      expression ':' expression { $$ = nodo_nuevo(ARENA, NODO_LLAVE_VALOR, $1, $3); }
+    ;
+
+subscript_expression:
+      TIDENTIFIER '[' expression ']' { $$ = nodo_nuevo(ARENA, NODO_INDICE, $1, $3); }
+    ;
+
 equality_expression:
-    expression OP_EQ expression { $$ = nodo_nuevo(NODO_IGUALDAD, $1, $3); }
+      expression OP_EQ expression { $$ = nodo_nuevo(ARENA, NODO_IGUALDAD, $1, $3); }
+    | expression OP_NEQ expression { $$ = nodo_nuevo(ARENA, NODO_DESIGUALDAD, $1, $3); }
+    ;
+
+relational_expression:
+      expression '<' expression { $$ = nodo_nuevo(ARENA, NODO_MENOR_QUE, $1, $3); }
+    | expression OP_LE expression { $$ = nodo_nuevo(ARENA, NODO_MENOR_IGUAL, $1, $3); }
+    | expression '>' expression { $$ = nodo_nuevo(ARENA, NODO_MAYOR_QUE, $1, $3); }
+    | expression OP_GE expression { $$ = nodo_nuevo(ARENA, NODO_MAYOR_IGUAL, $1, $3); }
+    ;
+
+additive_expression:
+      expression '+' expression { $$ = nodo_nuevo(ARENA, NODO_SUMA, $1, $3); }
+    | expression '-' expression { $$ = nodo_nuevo(ARENA, NODO_RESTA, $1, $3); }
+    ;
+
+multiplicative_expression:
+      expression '*' expression { $$ = nodo_nuevo(ARENA, NODO_MULTIPLICACION, $1, $3); }
+    | expression '/' expression { $$ = nodo_nuevo(ARENA, NODO_DIVISION, $1, $3); }
+    | expression '%' expression { $$ = nodo_nuevo(ARENA, NODO_MODULO, $1, $3); }
     ;
 
 program
@@ -86,11 +141,11 @@ program
 statement_list
     : statement_list statement {
         if($2){
-            $$ = nodo_nuevo(NODO_BLOQUE, $2, $1);
+            $$ = nodo_nuevo(ARENA, NODO_BLOQUE, $2, $1);
         }
     }
     | statement {
-        $$ = nodo_nuevo(NODO_BLOQUE, $1, NULL);
+        $$ = nodo_nuevo(ARENA, NODO_BLOQUE, $1, NULL);
     }
     ;
 
@@ -100,31 +155,53 @@ statement: /* empty */ { $$ = NULL; }
     | expression { $$ = $1; }
     | declaration { $$ = $1; }
     | function_call { $$ = $1; }
+    | function_definition { $$ = $1; }
+    | jump_statement { $$ = $1; }
     ;
 
 declaration:
-      TIDENTIFIER '=' expression { $$ = nodo_nuevo_asignacion($3, $1); }
+      TIDENTIFIER '=' expression { $$ = nodo_nuevo_asignacion(ARENA, $3, $1); }
+    | TIDENTIFIER '[' expression ']' '=' expression {
+        $$ = nodo_nuevo(ARENA, NODO_ASIGNACION_INDICE, $6, nodo_nuevo(ARENA, NODO_INDICE, $1, $3)); }
     ;
 
 selection_statement:
     KIF expression statement_list KEND {
-        $$ = nodo_nuevo_si($2, $3, NULL); }
+        $$ = nodo_nuevo_si(ARENA, $2, $3, NULL); }
     | KIF expression statement_list KELSE statement_list KEND {
-        $$ = nodo_nuevo_si($2, $3, $5); }
+        $$ = nodo_nuevo_si(ARENA, $2, $3, $5); }
+    ;
+
+function_definition:
+    KFUNCTION TIDENTIFIER '(' parameter_list ')' statement_list KEND {
+        $$ = nodo_nuevo_funcion(ARENA, $2, $4, $6); }
+    ;
+
+/* el ultimo parametro queda a la izquierda */
+parameter_list: /* empty */ { $$ = NULL; }
+    | TIDENTIFIER { $$ = nodo_nuevo(ARENA, NODO_LISTA_PARAMETROS, $1, NULL); }
+    | parameter_list ',' TIDENTIFIER { $$ = nodo_nuevo(ARENA, NODO_LISTA_PARAMETROS, $3, $1); }
+    ;
+
+jump_statement:
+    KRETURN expression { $$ = nodo_nuevo(ARENA, NODO_RETORNO, $2, NULL); }
     ;
 
 function_call:
-     TIDENTIFIER '(' argument_expression_list ')' { $$ = nodo_nuevo(NODO_FUNCION_LLAMADA, $1, $3); }
+     TIDENTIFIER '(' argument_expression_list ')' { $$ = nodo_nuevo(ARENA, NODO_FUNCION_LLAMADA, $1, $3); }
     ;
 
 argument_expression_list: /* empty */ { $$ = NULL; }
-    | expression { $$ = nodo_nuevo(NODO_FUNCION_ARGUMENTOS, $1, NULL); }
-    | expression ',' argument_expression_list { $$ = nodo_nuevo(NODO_FUNCION_ARGUMENTOS, $1, $3); }
+    | expression { $$ = nodo_nuevo(ARENA, NODO_FUNCION_ARGUMENTOS, $1, NULL); }
+    | expression ',' argument_expression_list { $$ = nodo_nuevo(ARENA, NODO_FUNCION_ARGUMENTOS, $1, $3); }
     ;
 
 expression
     : '(' expression ')' { $$ = $2; }
     | equality_expression
+    | relational_expression
+    | additive_expression
+    | multiplicative_expression
     | primary_expression
     | function_call
     ;
@@ -26,11 +26,14 @@ THE SOFTWARE.
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <time.h>
+#include <stdatomic.h>
 
 #include "latino.h"
 #include "ast.h"
 #include "utils.h"
 #include "libmem.h"
+#include "libstring.h"
 
 char* strdup0(const char* s)
 {
@@ -45,9 +48,8 @@ char* strdup0(const char* s)
     return p;
 }
 
-char* parse_string(const char* s, size_t len)
+char* parse_string(char* ret, const char* s, size_t len)
 {
-    char* ret = lat_asignar_memoria(len + 1);
     int i = 0;
     int j = 0;
     int c = '@';
@@ -248,93 +250,261 @@ int length_list(list_node* l)
     return a;
 }
 
-hash_map* make_hash_map()
+/* constantes de mezcla de wyhash */
+#define HASH_S0 0xa0761d6478bd642full
+#define HASH_S1 0xe7037ed1a0b428dbull
+#define HASH_S2 0x8ebc6af09c88c6e3ull
+#define HASH_S3 0x589965cc75374cc3ull
+
+static uint64_t hash_semilla = 0;
+/* 0: sin elegir, 1: un hilo la esta eligiendo, 2: lista */
+static atomic_int hash_semilla_estado = 0;
+
+/* producto de 64 x 64 bits: a recibe la parte baja y b la alta */
+static inline void hash_multiplicar(uint64_t* a, uint64_t* b)
 {
-    hash_map* ret = (hash_map*)lat_asignar_memoria(sizeof(hash_map));
-    int c;
-    for (c = 0; c < 256; c++)
-    {
-        ret->buckets[c] = NULL;
-    }
-    return ret;
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
 }
 
-int hash(char* key)
+static inline uint64_t hash_mezclar(uint64_t a, uint64_t b)
 {
-    int h = 5381;
+    hash_multiplicar(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t hash_leer64(const uint8_t* p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
 
-    unsigned char c;
-    for (c = *key; c != '\0'; c = *++key)
-        h = h * 33 + c;
+static inline uint64_t hash_leer32(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
 
-    return abs(h % 256);
+/* la semilla sale de /dev/urandom; si no existe se mezclan la hora y
+   direcciones de memoria (que cambian entre ejecuciones) */
+static void hash_elegir_semilla()
+{
+    uint64_t semilla = 0;
+    FILE* f = fopen("/dev/urandom", "rb");
+    if (f == NULL || fread(&semilla, sizeof(semilla), 1, f) != 1)
+    {
+        semilla = hash_mezclar((uint64_t)time(NULL) ^ HASH_S0, (uint64_t)clock() ^ HASH_S1);
+        semilla = hash_mezclar(semilla ^ (uint64_t)(uintptr_t)&semilla, (uint64_t)(uintptr_t)&hash_semilla ^ HASH_S2);
+    }
+    if (f != NULL)
+    {
+        fclose(f);
+    }
+    hash_semilla = semilla;
 }
 
-void* get_hash(hash_map* m, char* key)
+uint64_t lat_hash(const void* datos, size_t longitud)
 {
-    list_node* cur = m->buckets[hash(key)];
-    if (cur == NULL)
-        return NULL;
-    for (; cur->next != NULL; cur = cur->next)
+    const uint8_t* p = (const uint8_t*)datos;
+    uint64_t semilla;
+    uint64_t a, b;
+    if (atomic_load_explicit(&hash_semilla_estado, memory_order_acquire) != 2)
     {
-        if (cur->data != NULL)
+        int estado = 0;
+        if (atomic_compare_exchange_strong(&hash_semilla_estado, &estado, 1))
         {
-            if (strcmp(key, ((hash_val *)cur->data)->key) == 0)
+            hash_elegir_semilla();
+            atomic_store_explicit(&hash_semilla_estado, 2, memory_order_release);
+        }
+        else
+        {
+            while (atomic_load_explicit(&hash_semilla_estado, memory_order_acquire) != 2)
             {
-                return ((hash_val *)cur->data)->val;
+                ;
             }
         }
     }
-    return NULL;
-}
-
-void set_hash(hash_map *m, char *key, void *val)
-{
-    hash_val *hv = (hash_val *)lat_asignar_memoria(sizeof(hash_val));
-    strncpy(hv->key, key, (strlen(key)+1));
-    hv->val = val;
-    int hk = hash(key);
-    if (m->buckets[hk] == NULL)
+    semilla = hash_semilla ^ hash_mezclar(hash_semilla ^ HASH_S0, HASH_S1);
+    if (longitud <= 16)
     {
-        m->buckets[hk] = lat_crear_lista();
+        if (longitud >= 4)
+        {
+            size_t medio = (longitud >> 3) << 2;
+            a = (hash_leer32(p) << 32) | hash_leer32(p + medio);
+            b = (hash_leer32(p + longitud - 4) << 32) | hash_leer32(p + longitud - 4 - medio);
+        }
+        else if (longitud > 0)
+        {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[longitud >> 1] << 8) | p[longitud - 1];
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
     }
     else
     {
-        list_node *c;
-        for (c = m->buckets[hk]; c->next != NULL; c = c->next)
+        size_t i = longitud;
+        if (i > 48)
         {
-            if (c->data != NULL)
+            uint64_t s1 = semilla, s2 = semilla;
+            do
             {
-                if (strcmp(((hash_val *)c->data)->key, key) == 0)
-                {
-                    free(c->data);
-                    c->data = (void *)hv;
-                    return;
-                }
+                semilla = hash_mezclar(hash_leer64(p) ^ HASH_S1, hash_leer64(p + 8) ^ semilla);
+                s1 = hash_mezclar(hash_leer64(p + 16) ^ HASH_S2, hash_leer64(p + 24) ^ s1);
+                s2 = hash_mezclar(hash_leer64(p + 32) ^ HASH_S3, hash_leer64(p + 40) ^ s2);
+                p += 48;
+                i -= 48;
             }
+            while (i > 48);
+            semilla ^= s1 ^ s2;
+        }
+        while (i > 16)
+        {
+            semilla = hash_mezclar(hash_leer64(p) ^ HASH_S1, hash_leer64(p + 8) ^ semilla);
+            p += 16;
+            i -= 16;
         }
+        a = hash_leer64(p + i - 16);
+        b = hash_leer64(p + i - 8);
     }
-    insert_list(m->buckets[hk], (void *)hv);
+    a ^= HASH_S1;
+    b ^= semilla;
+    hash_multiplicar(&a, &b);
+    return hash_mezclar(a ^ HASH_S0 ^ longitud, b ^ HASH_S1);
 }
 
-hash_map *copy_hash(hash_map *m)
+/* sellos de version de las tablas hash, nunca se repiten (ni entre hilos) */
+static atomic_ulong hash_version = HASH_VERSION_VACIA;
+
+unsigned long hash_nueva_version()
 {
-    hash_map *ret = make_hash_map();
-    int i;
-    for (i = 0; i < 256; i++)
+    return atomic_fetch_add(&hash_version, 1) + 1;
+}
+
+/* capacidad de una tabla al guardar su primera llave */
+#define HASH_CAPACIDAD_INICIAL 8
+
+hash_map* make_hash_map()
+{
+    hash_map* ret = (hash_map*)lat_asignar_memoria(sizeof(hash_map));
+    ret->entradas = NULL;
+    ret->capacidad = 0;
+    ret->num_llaves = 0;
+    ret->version = HASH_VERSION_VACIA;
+    return ret;
+}
+
+/* entrada donde esta la llave o la entrada vacia donde se debe insertar */
+static hash_val* hash_buscar(hash_val* entradas, size_t capacidad, lat_objeto* key)
+{
+    size_t mascara = capacidad - 1;
+    size_t i = key->hash & mascara;
+    while (entradas[i].key != NULL && !lat_cadenas_iguales(entradas[i].key, key))
     {
-        list_node *c = m->buckets[i];
-        if (c != NULL)
+        i = (i + 1) & mascara;
+    }
+    return &entradas[i];
+}
+
+static void hash_crecer(hash_map* m)
+{
+    size_t capacidad = m->capacidad == 0 ? HASH_CAPACIDAD_INICIAL : m->capacidad * 2;
+    hash_val* entradas = (hash_val*)lat_asignar_memoria(sizeof(hash_val) * capacidad);
+    size_t i;
+    memset(entradas, 0, sizeof(hash_val) * capacidad);
+    for (i = 0; i < m->capacidad; i++)
+    {
+        if (m->entradas[i].key != NULL)
         {
-            for (; c->next != NULL; c = c->next)
-            {
-                if (c->data != NULL)
-                {
-                    set_hash(ret, ((hash_val *)c->data)->key, ((hash_val *)c->data)->val);
-                }
-            }
+            *hash_buscar(entradas, capacidad, m->entradas[i].key) = m->entradas[i];
         }
     }
+    lat_liberar_memoria(m->entradas);
+    m->entradas = entradas;
+    m->capacidad = capacidad;
+}
+
+hash_val* get_hash_val(hash_map* m, lat_objeto* key)
+{
+    hash_val* hv;
+    if (m->capacidad == 0)
+    {
+        return NULL;
+    }
+    hv = hash_buscar(m->entradas, m->capacidad, key);
+    return hv->key == NULL ? NULL : hv;
+}
+
+void* get_hash(hash_map* m, lat_objeto* key)
+{
+    hash_val* hv = get_hash_val(m, key);
+    return hv == NULL ? NULL : hv->val;
+}
+
+hash_val* set_hash(hash_map *m, lat_objeto *key, void *val)
+{
+    hash_val* hv = get_hash_val(m, key);
+    if (hv != NULL)
+    {
+        /* se reemplaza el valor sin mover la entrada */
+        hv->val = val;
+        return hv;
+    }
+    if ((m->num_llaves + 1) * 4 > m->capacidad * 3)
+    {
+        hash_crecer(m);
+    }
+    hv = hash_buscar(m->entradas, m->capacidad, key);
+    hv->key = key;
+    hv->val = val;
+    m->num_llaves++;
+    m->version = hash_nueva_version();
+    return hv;
+}
+
+void clear_hash(hash_map* m)
+{
+    if (m->num_llaves > 0)
+    {
+        memset(m->entradas, 0, sizeof(hash_val) * m->capacidad);
+        m->num_llaves = 0;
+        m->version = HASH_VERSION_VACIA;
+    }
+}
+
+void free_hash(hash_map* m)
+{
+    lat_liberar_memoria(m->entradas);
+    lat_liberar_memoria(m);
+}
+
+hash_map *copy_hash(hash_map *m)
+{
+    hash_map *ret = make_hash_map();
+    if (m->num_llaves > 0)
+    {
+        ret->version = hash_nueva_version();
+        ret->entradas = (hash_val*)lat_asignar_memoria(sizeof(hash_val) * m->capacidad);
+        memcpy(ret->entradas, m->entradas, sizeof(hash_val) * m->capacidad);
+        ret->capacidad = m->capacidad;
+        ret->num_llaves = m->num_llaves;
+    }
     return ret;
 }
 
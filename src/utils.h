@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <errno.h>
@@ -86,19 +87,56 @@ typedef struct list_node
     void* data;   /**< Informacion del nodo*/
 } list_node;
 
-/**\brief Valor hash */
+struct lat_objeto;
+
+/**\brief Entrada de la tabla hash */
 typedef struct hash_val
 {
-    char key[256];    /**< Llave */
+    struct lat_objeto* key;    /**< Llave (cadena internada), NULL si la entrada esta vacia */
     void* val;    /**< Valor */
 } hash_val;
 
-/**\brief Tabla hash */
+/**\brief Tabla hash
+  *
+  * Direccionamiento abierto con sondeo lineal: las entradas se guardan en un
+  * solo arreglo cuya capacidad es potencia de 2 y crece al doble cuando se
+  * llena a 3/4. Las llaves son cadenas internadas, se comparan por identidad
+  * y se ubican con el hash guardado en la cadena.
+  */
 typedef struct hash_map
 {
-    list_node* buckets[256];  /**< Arreglo de valores hash */
+    hash_val* entradas;     /**< Arreglo de entradas */
+    size_t capacidad;       /**< Numero de entradas reservadas (0 o potencia de 2) */
+    size_t num_llaves;      /**< Numero de entradas ocupadas */
+    unsigned long version;  /**< Sello unico que cambia cada vez que se agrega una llave; todas las tablas vacias comparten HASH_VERSION_VACIA */
 } hash_map;
 
+/**\brief Version de las tablas hash vacias: en cualquiera de ellas toda busqueda falla */
+#define HASH_VERSION_VACIA 1
+
+/**\brief Hash de una secuencia de bytes
+  *
+  * Funcion de la familia wyhash: procesa 8 bytes a la vez y mezcla con
+  * multiplicaciones de 64 x 64 -> 128 bits. Usa una semilla aleatoria que se
+  * elige una vez por proceso, asi que los hash (y el orden de las tablas)
+  * cambian entre ejecuciones y no se pueden elegir llaves que choquen. La
+  * usan la tabla de cadenas internadas, los contextos y los diccionarios.
+  *
+  *\param datos: Apuntador a los bytes
+  *\param longitud: Numero de bytes
+  *\return uint64_t: Hash de los datos
+  */
+uint64_t lat_hash(const void* datos, size_t longitud);
+
+/**\brief Genera un sello de version nuevo, distinto a los de todas las tablas
+  *
+  * Otras estructuras (p. ej. las formas de las instancias) toman sus versiones
+  * de la misma secuencia para que un cache no las confunda con una tabla.
+  *
+  *\return unsigned long: Version nueva
+  */
+unsigned long hash_nueva_version();
+
 /**\brief Conjunto hash */
 typedef struct hash_set
 {
@@ -154,28 +192,43 @@ int length_list(list_node* l);
   */
 hash_map* make_hash_map();
 
-/**\brief Crea un hash de una cadena
+/**\brief Obtiene un elemento de la tabla hash
   *
-  *\param key: Apuntador a cadena
-  *\return int: Numero hash creado para la cadena
+  *\param m: Apuntador a la tabla hash
+  *\param key: Llave buscada
+  *\return void*: Apuntador al objeto buscado
   */
-int hash(char* key);
+void* get_hash(hash_map* m, struct lat_objeto* key);
 
-/**\brief Obtiene un elemento de la tabla hash
+/**\brief Obtiene la entrada de la tabla hash donde se guarda una llave
+  *
+  * La entrada no cambia de lugar mientras la version de la tabla sea la misma,
+  * por lo que puede guardarse en un cache.
   *
   *\param m: Apuntador a la tabla hash
   *\param key: Llave buscada
-  *\return void*: Apuntador al objeto buscado
+  *\return hash_val*: Apuntador a la entrada o NULL si no existe
   */
-void* get_hash(hash_map* m, char* key);
+hash_val* get_hash_val(hash_map* m, struct lat_objeto* key);
 
 /**\brief Guarda un elemento en la tabla buscada
   *
   *\param m: Apuntador a la tabla hash
   *\param key: Llave
   *\param val: Valor
+  *\return hash_val*: Entrada de la tabla donde quedo el valor
   */
-void set_hash(hash_map* m, char* key, void* val);
+hash_val* set_hash(hash_map* m, struct lat_objeto* key, void* val);
+
+/**\brief Elimina todas las llaves de la tabla sin liberar los valores
+  *\param m: Apuntador a tabla hash
+  */
+void clear_hash(hash_map* m);
+
+/**\brief Libera la tabla hash sin liberar los valores
+  *\param m: Apuntador a tabla hash
+  */
+void free_hash(hash_map* m);
 
 /**\brief Copia una tabla hash con todos sus elementos
   *\param m: Apuntador a tabla hash
@@ -189,13 +242,14 @@ hash_map* copy_hash(hash_map* m);
   */
 char* strdup0(const char* s);
 
-/**\brief Analiza una cadena de caracteres
+/**\brief Analiza una cadena de caracteres (secuencias de escape)
   *
+  * \param ret: Destino, con espacio para n + 1 caracteres
   * \param s: Apuntador a una cadena de caracteres
   * \param n: Longitud de la cadena
-  * \return char*: Apuntador a una cadena de caracteres
+  * \return char*: ret
   */
-char* parse_string(const char* s, size_t n);
+char* parse_string(char* ret, const char* s, size_t n);
 
 /**\brief Concatena dos cadenas
   *
@@ -24,54 +24,147 @@ THE SOFTWARE.
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
 
 #include "vm.h"
 #include "utils.h"
 #include "libmem.h"
 #include "libstring.h"
+#include "libdict.h"
+
+/* funciones predefinidas en el contexto global; el indice es el argumento
+ * de CALL_BUILTIN */
+static const struct
+{
+    const char* nombre;
+    void (*funcion)(lat_mv*);
+} lat_nativas[] =
+{
+    { "==", lat_igualdad },
+    { "imprimir", lat_imprimir },
+    { "escribir", lat_imprimir },
+    { "salir", lat_salir },
+    { "longitud", lat_longitud },
+    { "contiene", lat_contiene },
+    { "eliminar", lat_eliminar },
+};
+
+#define LAT_NUM_NATIVAS ((int)(sizeof(lat_nativas) / sizeof(lat_nativas[0])))
+
+int lat_buscar_nativa(const char* nombre)
+{
+    int i;
+    for (i = 0; i < LAT_NUM_NATIVAS; i++)
+    {
+        if (strcmp(lat_nativas[i].nombre, nombre) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
 
 lat_mv* lat_crear_maquina_virtual()
 {
     lat_mv* ret = (lat_mv*)lat_asignar_memoria(sizeof(lat_mv));
-    ret->pila = lat_crear_lista();
+    int i;
+    lat_slab_iniciar(&ret->objetos, sizeof(lat_objeto));
+    ret->forma_vacia = lat_forma_vacia();
+    ret->pila = (lat_objeto**)lat_asignar_memoria(sizeof(lat_objeto*) * TAMANIO_PILA_INICIAL);
+    ret->tope_pila = 0;
+    ret->tamanio_pila = TAMANIO_PILA_INICIAL;
     ret->todos_objetos = lat_crear_lista();
     ret->basurero_objetos = lat_crear_lista();
     ret->modulos = lat_crear_lista();
     ret->memoria_usada = 0;
+    ret->umbral_recoleccion = UMBRAL_RECOLECCION;
+    ret->grises = NULL;
+    ret->num_grises = 0;
+    ret->tamanio_grises = 0;
     ret->objeto_cierto = lat_logico_nuevo(ret, true);
     ret->objeto_falso = lat_logico_nuevo(ret, false);
-    //memset(ret->registros, 0, 256);
-    memset(ret->contexto_pila, 0, 256);
+    ret->objeto_nulo = lat_crear_objeto(ret);
+    ret->objeto_cierto->inmortal = true;
+    ret->objeto_falso->inmortal = true;
+    ret->objeto_nulo->inmortal = true;
+    ret->modo_registros = false;
+    memset(ret->registros, 0, sizeof(ret->registros));
+    ret->contexto_pila = (lat_objeto**)lat_asignar_memoria(sizeof(lat_objeto*) * TAMANIO_MARCOS_INICIAL);
+    ret->tamanio_contexto = TAMANIO_MARCOS_INICIAL;
+    ret->marcos = (lat_marco*)lat_asignar_memoria(sizeof(lat_marco) * TAMANIO_MARCOS_INICIAL);
+    ret->num_marcos = 0;
+    ret->tamanio_marcos = TAMANIO_MARCOS_INICIAL;
     ret->contexto_pila[0] = lat_instancia(ret);
     ret->apuntador_pila = 0;
-    lat_asignar_contexto_objeto(lat_obtener_contexto(ret), lat_cadena_nueva(ret, "=="), lat_definir_cfuncion(ret, lat_igualdad));
-    lat_asignar_contexto_objeto(lat_obtener_contexto(ret), lat_cadena_nueva(ret, "imprimir"), lat_definir_cfuncion(ret, lat_imprimir));
-    lat_asignar_contexto_objeto(lat_obtener_contexto(ret), lat_cadena_nueva(ret, "escribir"), lat_definir_cfuncion(ret, lat_imprimir));
-    lat_asignar_contexto_objeto(lat_obtener_contexto(ret), lat_cadena_nueva(ret, "salir"), lat_definir_cfuncion(ret, lat_salir));
+    ret->nombres_nativas = (lat_objeto**)lat_asignar_memoria(sizeof(lat_objeto*) * LAT_NUM_NATIVAS);
+    for (i = 0; i < LAT_NUM_NATIVAS; i++)
+    {
+        ret->nombres_nativas[i] = lat_cadena_nueva(ret, lat_nativas[i].nombre);
+        lat_asignar_contexto_objeto(ret, lat_obtener_contexto(ret), ret->nombres_nativas[i], lat_definir_cfuncion(ret, lat_nativas[i].funcion));
+    }
     return ret;
 }
 
+static void lat_liberar_nodos(list_node* l)
+{
+    while (l != NULL)
+    {
+        list_node* siguiente = l->next;
+        lat_liberar_memoria(l);
+        l = siguiente;
+    }
+}
+
+void lat_destruir_maquina_virtual(lat_mv *mv)
+{
+    /* sin raices ningun objeto queda marcado: el barrido libera los datos de
+     * todos los que no son inmortales y despues se liberan las paginas */
+    lat_slab_barrer(&mv->objetos, lat_barrer_objeto, mv);
+    lat_slab_destruir(&mv->objetos);
+    lat_forma_destruir(mv->forma_vacia);
+    lat_liberar_nodos(mv->todos_objetos);
+    lat_liberar_nodos(mv->basurero_objetos);
+    lat_liberar_nodos(mv->modulos);
+    lat_liberar_memoria(mv->pila);
+    lat_liberar_memoria(mv->contexto_pila);
+    lat_liberar_memoria(mv->marcos);
+    lat_liberar_memoria(mv->grises);
+    lat_liberar_memoria(mv->nombres_nativas);
+    lat_liberar_memoria(mv);
+}
+
+void lat_reservar_pila(lat_mv *mv, int n)
+{
+    if (mv->tope_pila + n > mv->tamanio_pila)
+    {
+        int tamanio = mv->tamanio_pila * 2;
+        while (mv->tope_pila + n > tamanio)
+        {
+            tamanio *= 2;
+        }
+        mv->pila = (lat_objeto**)lat_reasignar_memoria(mv->pila, sizeof(lat_objeto*) * tamanio);
+        mv->tamanio_pila = tamanio;
+    }
+}
+
 void lat_apilar(lat_mv *mv, lat_objeto* o)
 {
-    insert_list(mv->pila, (void*)o);
+    if (mv->tope_pila == mv->tamanio_pila)
+    {
+        lat_reservar_pila(mv, 1);
+    }
+    mv->pila[mv->tope_pila++] = o;
 }
 
 lat_objeto* lat_desapilar(lat_mv *mv)
 {
-    list_node* n = mv->pila->next;
-    if (n->data == NULL)
+    if (mv->tope_pila == 0)
     {
         lat_registrar_error("Pila vacia");
+        return NULL;
     }
-    else
-    {
-        n->prev->next = n->next;
-        n->next->prev = n->prev;
-        lat_objeto* ret = (lat_objeto*)n->data;
-        lat_liberar_memoria(n);
-        return ret;
-    }
-    return NULL;
+    return mv->pila[--mv->tope_pila];
 }
 
 void lat_apilar_lista(lat_objeto* lista, lat_objeto* o)
@@ -96,31 +189,44 @@ lat_objeto* lat_desapilar_lista(lat_objeto* lista)
     return NULL;
 }
 
-void lat_apilar_contexto(lat_mv *mv)
+/* la pila de contextos crece al doble cuando se llena */
+static void lat_reservar_contexto(lat_mv *mv)
 {
-    if (mv->apuntador_pila >= MAX_STACK_SIZE)
+    if (mv->apuntador_pila + 1 >= mv->tamanio_contexto)
     {
-        lat_registrar_error("Namespace desborde de la pila");
+        mv->tamanio_contexto *= 2;
+        mv->contexto_pila = (lat_objeto**)lat_reasignar_memoria(mv->contexto_pila, sizeof(lat_objeto*) * mv->tamanio_contexto);
     }
-    mv->contexto_pila[mv->apuntador_pila + 1] = lat_clonar_objeto(mv, mv->contexto_pila[mv->apuntador_pila]);
+}
+
+void lat_apilar_contexto(lat_mv *mv)
+{
+    lat_reservar_contexto(mv);
+    mv->contexto_pila[mv->apuntador_pila + 1] = lat_instancia(mv);
     mv->apuntador_pila++;
 }
 
 void lat_desapilar_contexto(lat_mv *mv)
 {
+    lat_objeto* ctx;
     if (mv->apuntador_pila == 0)
     {
         lat_registrar_error("Namespace pila vacia");
+        return;
+    }
+    /* los valores pueden seguir en uso (p. ej. el resultado de la funcion),
+     * solo se liberan los atributos del contexto; si una funcion definida en
+     * el lo guarda como su alcance lo libera el recolector */
+    ctx = mv->contexto_pila[mv->apuntador_pila--];
+    if (!ctx->datos.atributos->capturado)
+    {
+        lat_instancia_liberar(mv, ctx);
     }
-    lat_eliminar_objeto(mv, mv->contexto_pila[mv->apuntador_pila--]);
 }
 
 void lat_apilar_contexto_predefinido(lat_mv *mv, lat_objeto* ctx)
 {
-    if (mv->apuntador_pila >= 255)
-    {
-        lat_registrar_error("Namespace desborde de la pila");
-    }
+    lat_reservar_contexto(mv);
     mv->contexto_pila[++mv->apuntador_pila] = ctx;
 }
 
@@ -138,12 +244,105 @@ lat_objeto* lat_obtener_contexto(lat_mv *mv)
     return mv->contexto_pila[mv->apuntador_pila];
 }
 
-lat_objeto* lat_definir_funcion(lat_mv *mv, lat_bytecode* inslist, int num_params)
+lat_funcion* lat_crear_funcion(int num_params)
 {
-    lat_objeto* ret = lat_funcion_nueva(mv);
     lat_funcion* fval = (lat_funcion*)lat_asignar_memoria(sizeof(lat_funcion));
-    fval->bcode = inslist;
     fval->num_params = num_params;
+    fval->params = NULL;
+    fval->bcode = (lat_bytecode*)lat_asignar_memoria(sizeof(lat_bytecode) * MAX_BYTECODE_FUNCTION);
+    fval->num_bcode = 0;
+    fval->constantes = NULL;
+    fval->num_constantes = 0;
+    fval->max_pila = 0;
+    fval->caches = NULL;
+    fval->num_locales = 0;
+    fval->usa_registros = false;
+    fval->contexto_local = false;
+    return fval;
+}
+
+void lat_terminar_funcion(lat_funcion* fun, int num_bcode)
+{
+    int i;
+    fun->num_bcode = num_bcode;
+    fun->bcode = (lat_bytecode*)lat_reasignar_memoria(fun->bcode, sizeof(lat_bytecode) * num_bcode);
+    fun->max_pila = lat_calcular_max_pila(fun->bcode, num_bcode);
+    /* la version 0 nunca la tiene una tabla, todos los caches inician vacios */
+    fun->caches = (lat_cache_nombre*)lat_asignar_memoria(sizeof(lat_cache_nombre) * num_bcode);
+    memset(fun->caches, 0, sizeof(lat_cache_nombre) * num_bcode);
+    /* solo se guardan los registros al llamar desde funciones que los usan y
+     * solo se crea un contexto local para las funciones que asignan por nombre */
+    for (i = 0; i < num_bcode; i++)
+    {
+        if (LAT_INS(fun->bcode[i]) >= LOAD_CONST_R)
+        {
+            fun->usa_registros = true;
+        }
+        else if (LAT_INS(fun->bcode[i]) == STORE_NAME)
+        {
+            fun->contexto_local = true;
+        }
+    }
+    lat_fusionar_instrucciones(fun);
+}
+
+void lat_fusionar_instrucciones(lat_funcion* fun)
+{
+    lat_bytecode* bc = fun->bcode;
+    int n = fun->num_bcode;
+    int i;
+    for (i = 0; i < n; i++)
+    {
+        /* si (a == 10) */
+        if (i + 3 < n && (LAT_INS(bc[i]) == LOAD_NAME || LAT_INS(bc[i]) == LOAD_GLOBAL) && LAT_INS(bc[i + 1]) == LOAD_CONST
+                && LAT_INS(bc[i + 2]) >= COMPARE_OP_LT && LAT_INS(bc[i + 2]) <= COMPARE_OP_NEQ
+                && LAT_INS(bc[i + 3]) == POP_JUMP_IF_FALSE)
+        {
+            bc[i] = lat_bc(COMPARE_CONST_JUMP_IF_FALSE, LAT_ARG(bc[i]));
+            i += 3;
+        }
+        /* escribir("hola") */
+        else if (i + 2 < n && LAT_INS(bc[i]) == LOAD_CONST
+                 && (LAT_INS(bc[i + 1]) == LOAD_NAME || LAT_INS(bc[i + 1]) == LOAD_GLOBAL)
+                 && LAT_INS(bc[i + 2]) == CALL_FUNCTION && LAT_ARG(bc[i + 2]) == 1)
+        {
+            bc[i] = lat_bc(CALL_NAME_1, LAT_ARG(bc[i]));
+            i += 2;
+        }
+    }
+}
+
+int lat_agregar_constante(lat_funcion* fun, lat_objeto* o)
+{
+    int i;
+    if (lat_tipo(o) == T_STR || lat_es_etiquetado(o))
+    {
+        for (i = 0; i < fun->num_constantes; i++)
+        {
+            if (fun->constantes[i] == o)
+            {
+                return i;
+            }
+        }
+    }
+    if (fun->num_constantes > LAT_ARG_MAX)
+    {
+        lat_registrar_error("Demasiadas constantes en la funcion");
+        return -1;
+    }
+    /* la tabla crece en potencias de 2 */
+    if ((fun->num_constantes & (fun->num_constantes - 1)) == 0)
+    {
+        int tamanio = fun->num_constantes == 0 ? 4 : fun->num_constantes * 2;
+        fun->constantes = (lat_objeto**)lat_reasignar_memoria(fun->constantes, sizeof(lat_objeto*) * tamanio);
+    }
+    fun->constantes[fun->num_constantes] = o;
+    return fun->num_constantes++;
+}
+
+lat_objeto* lat_definir_funcion(lat_mv *mv, lat_funcion* fval)
+{
+    lat_objeto* ret = lat_funcion_nueva(mv);
     ret->datos.funcion = fval;
     //mv->memoria_usada += sizeof(sizeof(lat_function));
     return ret;
@@ -156,26 +355,84 @@ lat_objeto* lat_definir_cfuncion(lat_mv *mv, void (*function)(lat_mv *mv))
     return ret;
 }
 
+/* valor dentro de un diccionario: las cadenas van entre comillas */
+static void lat_imprimir_elemento(lat_mv *mv, lat_objeto* o)
+{
+    switch (lat_tipo(o))
+    {
+    case T_NULO:
+        fprintf(stdout, "nulo");
+        break;
+    case T_INT:
+        fprintf(stdout, "%ld", lat_obtener_entero(o));
+        break;
+    case T_DOUBLE:
+        fprintf(stdout, "%g", o->datos.decimal);
+        break;
+    case T_STR:
+        fprintf(stdout, "\"%s\"", lat_obtener_cadena(o));
+        break;
+    case T_BOOL:
+        fprintf(stdout, "%s", o->datos.logico ? "verdadero" : "falso");
+        break;
+    case T_DICT:
+        lat_imprimir_diccionario(mv, o->datos.diccionario);
+        break;
+    case T_FUNC:
+        fprintf(stdout, "Funcion");
+        break;
+    case T_CFUNC:
+        fprintf(stdout, "C_Funcion");
+        break;
+    default:
+        fprintf(stdout, "Objeto");
+        break;
+    }
+}
+
+void lat_imprimir_diccionario(lat_mv *mv, lat_diccionario* d)
+{
+    size_t i;
+    bool primero = true;
+    fprintf(stdout, "{");
+    for (i = 0; i < d->capacidad; i++)
+    {
+        if (d->control[i] != LAT_DIC_VACIO)
+        {
+            fprintf(stdout, primero ? "" : ", ");
+            lat_imprimir_elemento(mv, d->entradas[i].llave);
+            fprintf(stdout, ": ");
+            lat_imprimir_elemento(mv, d->entradas[i].valor);
+            primero = false;
+        }
+    }
+    fprintf(stdout, "}");
+}
+
 void lat_imprimir(lat_mv *mv)
 {
     lat_objeto* in = lat_desapilar(mv);
-    if (in->tipo == T_NULO)
+    if (lat_tipo(in) == T_NULO)
     {
         fprintf(stdout, "%s\n", "nulo");
     }
-    else if (in->tipo == T_INSTANCE)
+    else if (lat_tipo(in) == T_INSTANCE)
     {
         fprintf(stdout, "%s\n", "Objeto");
     }
-    else if (in->tipo == T_INT)
+    else if (lat_tipo(in) == T_INT)
     {
         fprintf(stdout, "%ld\n", lat_obtener_entero(in));
     }
-    else if (in->tipo == T_STR)
+    else if (lat_tipo(in) == T_DOUBLE)
+    {
+        fprintf(stdout, "%g\n", lat_obtener_decimal(in));
+    }
+    else if (lat_tipo(in) == T_STR)
     {
         fprintf(stdout, "%s\n", lat_obtener_cadena(in));
     }
-    else if (in->tipo == T_BOOL)
+    else if (lat_tipo(in) == T_BOOL)
     {
         if (lat_obtener_logico(in))
         {
@@ -186,17 +443,22 @@ void lat_imprimir(lat_mv *mv)
             fprintf(stdout, "%s\n", "falso");
         }
     }
-    else if (in->tipo == T_FUNC)
+    else if (lat_tipo(in) == T_FUNC)
     {
         fprintf(stdout, "%s\n", "Funcion");
     }
-    else if (in->tipo == T_CFUNC)
+    else if (lat_tipo(in) == T_CFUNC)
     {
         fprintf(stdout, "%s\n", "C_Funcion");
     }
+    else if (lat_tipo(in) == T_DICT)
+    {
+        lat_imprimir_diccionario(mv, in->datos.diccionario);
+        fprintf(stdout, "\n");
+    }
     else
     {
-        fprintf(stdout, "Tipo desconocido %d\n", in->tipo);
+        fprintf(stdout, "Tipo desconocido %d\n", lat_tipo(in));
     }
     lat_apilar(mv, in);
 }
@@ -208,30 +470,374 @@ void lat_clonar(lat_mv *mv)
 }
 
 void lat_igualdad(lat_mv *mv)
+{
+    lat_operador_binario(mv, COMPARE_OP_EQ);
+}
+
+/* operaciones enteras que detectan el desbordamiento: regresan falso si el
+ * resultado no cabe en un long */
+static inline bool lat_sumar_enteros(long a, long b, long* r)
+{
+#if defined(__GNUC__)
+    return !__builtin_add_overflow(a, b, r);
+#else
+    if ((b > 0 && a > LONG_MAX - b) || (b < 0 && a < LONG_MIN - b))
+    {
+        return false;
+    }
+    *r = a + b;
+    return true;
+#endif
+}
+
+static inline bool lat_restar_enteros(long a, long b, long* r)
+{
+#if defined(__GNUC__)
+    return !__builtin_sub_overflow(a, b, r);
+#else
+    if ((b < 0 && a > LONG_MAX + b) || (b > 0 && a < LONG_MIN + b))
+    {
+        return false;
+    }
+    *r = a - b;
+    return true;
+#endif
+}
+
+static inline bool lat_multiplicar_enteros(long a, long b, long* r)
+{
+#if defined(__GNUC__)
+    return !__builtin_mul_overflow(a, b, r);
+#else
+    if (a > 0 ? (b > 0 ? a > LONG_MAX / b : b < LONG_MIN / a)
+            : (b > 0 ? a < LONG_MIN / b : (a != 0 && b < LONG_MAX / a)))
+    {
+        return false;
+    }
+    *r = a * b;
+    return true;
+#endif
+}
+
+/* division entera redondeando hacia abajo; LONG_MIN / -1 no cabe en un long
+ * y lo resuelve quien llama */
+static long lat_division_entera(long a, long b)
+{
+    long q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0)))
+    {
+        q--;
+    }
+    return q;
+}
+
+/* modulo entero con el signo del divisor; con b == -1 el modulo es 0 (y
+ * LONG_MIN % -1 desborda) */
+static long lat_modulo_entero(long a, long b)
+{
+    long r;
+    if (b == -1)
+    {
+        return 0;
+    }
+    r = a % b;
+    if ((r != 0) && ((r < 0) != (b < 0)))
+    {
+        r += b;
+    }
+    return r;
+}
+
+static bool lat_es_numero(lat_objeto* o)
+{
+    return lat_tipo(o) == T_INT || lat_tipo(o) == T_DOUBLE;
+}
+
+/* apila verdadero o falso segun el resultado de comparar (-1, 0, 1) */
+static void lat_apilar_comparacion(lat_mv *mv, lat_ins ins, int cmp)
+{
+    bool r = false;
+    switch (ins)
+    {
+    case COMPARE_OP_LT:
+        r = cmp < 0;
+        break;
+    case COMPARE_OP_LTE:
+        r = cmp <= 0;
+        break;
+    case COMPARE_OP_GT:
+        r = cmp > 0;
+        break;
+    case COMPARE_OP_GTE:
+        r = cmp >= 0;
+        break;
+    case COMPARE_OP_EQ:
+        r = cmp == 0;
+        break;
+    case COMPARE_OP_NEQ:
+        r = cmp != 0;
+        break;
+    default:
+        break;
+    }
+    lat_apilar(mv, r ? mv->objeto_cierto : mv->objeto_falso);
+}
+
+/* representacion como cadena de un objeto para la concatenacion; la
+ * longitud de una cadena es la que guarda el objeto */
+static const char* lat_texto_objeto(lat_objeto* o, char* buffer, size_t tamanio, size_t* longitud)
+{
+    const char* texto;
+    switch (lat_tipo(o))
+    {
+    case T_STR:
+        *longitud = lat_cadena_longitud(o);
+        return lat_obtener_cadena(o);
+    case T_INT:
+        snprintf(buffer, tamanio, "%ld", lat_obtener_entero(o));
+        texto = buffer;
+        break;
+    case T_DOUBLE:
+        snprintf(buffer, tamanio, "%g", o->datos.decimal);
+        texto = buffer;
+        break;
+    case T_BOOL:
+        texto = o->datos.logico ? "verdadero" : "falso";
+        break;
+    case T_NULO:
+        texto = "nulo";
+        break;
+    default:
+        texto = "Objeto";
+        break;
+    }
+    *longitud = strlen(texto);
+    return texto;
+}
+
+void lat_operador_binario(lat_mv *mv, lat_ins ins)
 {
     lat_objeto* b = lat_desapilar(mv);
     lat_objeto* a = lat_desapilar(mv);
-    if (a->tipo == T_BOOL && b->tipo == T_BOOL)
+    if (lat_es_numero(a) && lat_es_numero(b))
     {
-        lat_apilar(mv, lat_obtener_logico(a) == lat_obtener_logico(b) ? mv->objeto_cierto : mv->objeto_falso);
-        return;
+        if (lat_tipo(a) == T_INT && lat_tipo(b) == T_INT)
+        {
+            /* un resultado que no cabe en un long se da como decimal */
+            long x = lat_obtener_entero(a);
+            long y = lat_obtener_entero(b);
+            long r;
+            switch (ins)
+            {
+            case BINARY_ADD:
+                lat_apilar(mv, lat_sumar_enteros(x, y, &r) ? lat_entero_nuevo(mv, r)
+                    : lat_decimal_nuevo(mv, (double)x + (double)y));
+                return;
+            case BINARY_SUBTRACT:
+                lat_apilar(mv, lat_restar_enteros(x, y, &r) ? lat_entero_nuevo(mv, r)
+                    : lat_decimal_nuevo(mv, (double)x - (double)y));
+                return;
+            case BINARY_MULTIPLY:
+                lat_apilar(mv, lat_multiplicar_enteros(x, y, &r) ? lat_entero_nuevo(mv, r)
+                    : lat_decimal_nuevo(mv, (double)x * (double)y));
+                return;
+            case BINARY_FLOOR_DIVIDE:
+            case BINARY_MODULO:
+                if (y == 0)
+                {
+                    lat_registrar_error("Division entre cero");
+                    lat_apilar(mv, lat_crear_objeto(mv));
+                    return;
+                }
+                if (ins == BINARY_FLOOR_DIVIDE && x == LONG_MIN && y == -1)
+                {
+                    lat_apilar(mv, lat_decimal_nuevo(mv, -(double)LONG_MIN));
+                    return;
+                }
+                lat_apilar(mv, lat_entero_nuevo(mv, ins == BINARY_MODULO ?
+                    lat_modulo_entero(x, y) : lat_division_entera(x, y)));
+                return;
+            default:
+                lat_apilar_comparacion(mv, ins, (x > y) - (x < y));
+                return;
+            }
+        }
+        else
+        {
+            double x = lat_obtener_decimal(a);
+            double y = lat_obtener_decimal(b);
+            switch (ins)
+            {
+            case BINARY_ADD:
+                lat_apilar(mv, lat_decimal_nuevo(mv, x + y));
+                return;
+            case BINARY_SUBTRACT:
+                lat_apilar(mv, lat_decimal_nuevo(mv, x - y));
+                return;
+            case BINARY_MULTIPLY:
+                lat_apilar(mv, lat_decimal_nuevo(mv, x * y));
+                return;
+            case BINARY_FLOOR_DIVIDE:
+                if (y == 0)
+                {
+                    lat_registrar_error("Division entre cero");
+                    lat_apilar(mv, lat_crear_objeto(mv));
+                    return;
+                }
+                lat_apilar(mv, lat_decimal_nuevo(mv, floor(x / y)));
+                return;
+            case BINARY_MODULO:
+                if (y == 0)
+                {
+                    lat_registrar_error("Division entre cero");
+                    lat_apilar(mv, lat_crear_objeto(mv));
+                    return;
+                }
+                lat_apilar(mv, lat_decimal_nuevo(mv, x - y * floor(x / y)));
+                return;
+            default:
+                lat_apilar_comparacion(mv, ins, (x > y) - (x < y));
+                return;
+            }
+        }
     }
-    if ((a->tipo == T_INT) && (b->tipo == T_INT ))
+    if (ins == BINARY_ADD && (lat_tipo(a) == T_STR || lat_tipo(b) == T_STR))
     {
-        lat_apilar(mv, (lat_obtener_entero(a) == lat_obtener_entero(b)) ? mv->objeto_cierto : mv->objeto_falso);
+        char ba[64];
+        char bb[64];
+        size_t la, lb;
+        const char* ta = lat_texto_objeto(a, ba, sizeof(ba), &la);
+        const char* tb = lat_texto_objeto(b, bb, sizeof(bb), &lb);
+        /* el resultado es una cadena de la MV, no se interna: la libera el
+           colector cuando ya no se usa */
+        lat_apilar(mv, lat_cadena_concatenar(mv, ta, la, tb, lb));
         return;
     }
-    lat_apilar(mv, mv->objeto_falso);
+    if (ins >= COMPARE_OP_LT && ins <= COMPARE_OP_NEQ)
+    {
+        if (lat_tipo(a) == T_STR && lat_tipo(b) == T_STR)
+        {
+            /* la igualdad se decide con el hash y la longitud guardados */
+            if (ins == COMPARE_OP_EQ || ins == COMPARE_OP_NEQ)
+            {
+                lat_apilar_comparacion(mv, ins, lat_cadenas_iguales(a, b) ? 0 : 1);
+                return;
+            }
+            lat_apilar_comparacion(mv, ins, lat_cadena_comparar(a, b));
+            return;
+        }
+        if (ins == COMPARE_OP_EQ || ins == COMPARE_OP_NEQ)
+        {
+            bool iguales;
+            if (lat_tipo(a) == T_BOOL && lat_tipo(b) == T_BOOL)
+            {
+                iguales = lat_obtener_logico(a) == lat_obtener_logico(b);
+            }
+            else
+            {
+                iguales = (a == b) || (lat_tipo(a) == T_NULO && lat_tipo(b) == T_NULO);
+            }
+            lat_apilar_comparacion(mv, ins, iguales ? 0 : 1);
+            return;
+        }
+    }
+    lat_registrar_error("Operacion no soportada entre los tipos %d y %d", lat_tipo(a), lat_tipo(b));
+    lat_apilar(mv, lat_crear_objeto(mv));
 }
 
-lat_bytecode lat_bc(lat_ins i, void* a, void* b, void* c)
+lat_bytecode lat_bc(lat_ins i, int a)
 {
-    lat_bytecode ret;
-    ret.ins = i;
-    ret.a = a;
-    ret.b = b;
-    ret.c = c;
-    return ret;
+    return (lat_bytecode)i | ((lat_bytecode)a << 8);
+}
+
+int lat_calcular_max_pila(lat_bytecode* inslist, int n)
+{
+    int i;
+    int prof = 0;
+    int max = 0;
+    for (i = 0; i < n; i++)
+    {
+        switch (LAT_INS(inslist[i]))
+        {
+        case LOAD_CONST:
+        case LOAD_NAME:
+        case LOAD_FAST:
+        case LOAD_GLOBAL:
+        case MAKE_FUNCTION:
+            prof++;
+            break;
+        case STORE_NAME:
+        case STORE_FAST:
+        case STORE_GLOBAL:
+        case POP_JUMP_IF_FALSE:
+        case POP_JUMP_IF_TRUE:
+        case BINARY_ADD:
+        case BINARY_SUBTRACT:
+        case BINARY_MULTIPLY:
+        case BINARY_FLOOR_DIVIDE:
+        case BINARY_MODULO:
+        case COMPARE_OP_LT:
+        case COMPARE_OP_LTE:
+        case COMPARE_OP_GT:
+        case COMPARE_OP_GTE:
+        case COMPARE_OP_EQ:
+        case COMPARE_OP_NEQ:
+            prof--;
+            break;
+        case CALL_FUNCTION:
+        case TAIL_CALL:
+            /* saca la funcion y sus argumentos, apila el resultado */
+            prof -= LAT_ARG(inslist[i]);
+            break;
+        case CALL_BUILTIN:
+            /* saca los argumentos, apila el resultado */
+            prof -= LAT_B(inslist[i]) - 1;
+            break;
+        case BUILD_MAP:
+            prof -= 2 * LAT_ARG(inslist[i]) - 1;
+            break;
+        case BINARY_SUBSCR:
+            prof--;
+            break;
+        case STORE_SUBSCR:
+            prof -= 3;
+            break;
+        case PUSH_R:
+            prof++;
+            break;
+        case POP_R:
+            prof--;
+            break;
+        case BINARY_ADD_R:
+        case BINARY_SUBTRACT_R:
+        case BINARY_MULTIPLY_R:
+        case BINARY_FLOOR_DIVIDE_R:
+        case BINARY_MODULO_R:
+        case COMPARE_OP_LT_R:
+        case COMPARE_OP_LTE_R:
+        case COMPARE_OP_GT_R:
+        case COMPARE_OP_GTE_R:
+        case COMPARE_OP_EQ_R:
+        case COMPARE_OP_NEQ_R:
+            /* los operandos que no son enteros pasan por la pila */
+            if (prof + 2 > max)
+            {
+                max = prof + 2;
+            }
+            break;
+        default:
+            break;
+        }
+        if (prof < 0)
+        {
+            prof = 0;
+        }
+        if (prof > max)
+        {
+            max = prof;
+        }
+    }
+    return max;
 }
 
 void lista_modificar_elemento(list_node* l, void* data, int pos)
@@ -272,137 +878,831 @@ lat_objeto* lista_obtener_elemento(list_node* l, int pos)
     return NULL;
 }
 
-lat_objeto* lat_llamar_funcion(lat_mv *mv, lat_objeto* func)
+/* Despacho de instrucciones.
+ *
+ * Con GCC/Clang cada instruccion salta directamente a la siguiente por medio
+ * de una tabla de direcciones de etiquetas (computed goto), asi cada
+ * instruccion tiene su propio salto indirecto y el predictor de saltos puede
+ * aprender las secuencias mas comunes. Con otros compiladores (o compilando
+ * con LAT_SIN_DESPACHO_COMPUTADO) se usa el switch portable.
+ */
+#if defined(__GNUC__) && !defined(LAT_SIN_DESPACHO_COMPUTADO)
+#define LAT_DESPACHO_COMPUTADO 1
+#endif
+
+#ifdef LAT_DESPACHO_COMPUTADO
+#define INSTRUCCION(op) et_##op: case op
+#define DESPACHAR() goto *tabla_despacho[LAT_INS(*pc)]
+#else
+#define INSTRUCCION(op) case op
+#define DESPACHAR() continue
+#endif
+
+#define SIGUIENTE() { pc++; DESPACHAR(); }
+
+/* Al entrar a una funcion (y al regresar de cada llamada) se reserva su
+ * profundidad maxima de pila, por lo que las instrucciones apilan sin
+ * verificar limites salvo que se defina LAT_VERIFICAR_PILA. */
+#ifdef LAT_VERIFICAR_PILA
+#define APILAR(o) lat_apilar(mv, (o))
+#define DESAPILAR() lat_desapilar(mv)
+#else
+#define APILAR(o) (mv->pila[mv->tope_pila++] = (o))
+#define DESAPILAR() (mv->pila[--mv->tope_pila])
+#endif
+#define SALTAR(destino) { pc = inslist + (destino); DESPACHAR(); }
+
+/* Operaciones entre enteros etiquetados: se resuelven en linea sin llamadas ni
+ * memoria; cualquier otra combinacion de tipos (o un entero fuera del rango
+ * etiquetado) pasa por lat_operador_binario. La suma y la resta de dos
+ * etiquetados siempre caben en un long; el producto se verifica y si desborda
+ * tambien pasa por lat_operador_binario. Las comparaciones
+ * apilan los objetos compartidos objeto_cierto / objeto_falso. */
+#define ARITMETICA_ENTERA(op, cond, expr) \
+    { \
+        lat_objeto* b = mv->pila[mv->tope_pila - 1]; \
+        lat_objeto* a = mv->pila[mv->tope_pila - 2]; \
+        if (lat_ambos_etiquetados(a, b)) \
+        { \
+            long x = lat_valor_etiquetado(a); \
+            long y = lat_valor_etiquetado(b); \
+            if (cond) \
+            { \
+                mv->tope_pila--; \
+                mv->pila[mv->tope_pila - 1] = lat_entero_nuevo(mv, (expr)); \
+                SIGUIENTE(); \
+            } \
+        } \
+        lat_operador_binario(mv, op); \
+        SIGUIENTE(); \
+    }
+
+#define COMPARACION_ENTERA(op, cmp) \
+    { \
+        lat_objeto* b = mv->pila[mv->tope_pila - 1]; \
+        lat_objeto* a = mv->pila[mv->tope_pila - 2]; \
+        if (lat_ambos_etiquetados(a, b)) \
+        { \
+            mv->tope_pila--; \
+            mv->pila[mv->tope_pila - 1] = (lat_valor_etiquetado(a) cmp lat_valor_etiquetado(b)) ? \
+                mv->objeto_cierto : mv->objeto_falso; \
+            SIGUIENTE(); \
+        } \
+        lat_operador_binario(mv, op); \
+        SIGUIENTE(); \
+    }
+
+/* Instrucciones de registros: los operandos B y C son un registro o, con el
+ * bit LAT_RK_CONSTANTE, una constante de la funcion. Los enteros se resuelven
+ * en linea; el resto pasa por lat_operador_binario usando la pila. */
+#define RK(x) (((x) & LAT_RK_CONSTANTE) ? constantes[(x) & ~LAT_RK_CONSTANTE] : mv->registros[(x)])
+
+#define OPERADOR_REGISTROS(op) \
+    { \
+        APILAR(a); \
+        APILAR(b); \
+        lat_operador_binario(mv, op); \
+        mv->registros[LAT_A(*pc)] = DESAPILAR(); \
+        SIGUIENTE(); \
+    }
+
+#define ARITMETICA_REGISTROS(op, cond, expr) \
+    { \
+        lat_objeto* a = RK(LAT_B(*pc)); \
+        lat_objeto* b = RK(LAT_C(*pc)); \
+        if (lat_ambos_etiquetados(a, b)) \
+        { \
+            long x = lat_valor_etiquetado(a); \
+            long y = lat_valor_etiquetado(b); \
+            if (cond) \
+            { \
+                mv->registros[LAT_A(*pc)] = lat_entero_nuevo(mv, (expr)); \
+                SIGUIENTE(); \
+            } \
+        } \
+        OPERADOR_REGISTROS(op); \
+    }
+
+#define COMPARACION_REGISTROS(op, cmp) \
+    { \
+        lat_objeto* a = RK(LAT_B(*pc)); \
+        lat_objeto* b = RK(LAT_C(*pc)); \
+        if (lat_ambos_etiquetados(a, b)) \
+        { \
+            mv->registros[LAT_A(*pc)] = (lat_valor_etiquetado(a) cmp lat_valor_etiquetado(b)) ? \
+                mv->objeto_cierto : mv->objeto_falso; \
+            SIGUIENTE(); \
+        } \
+        OPERADOR_REGISTROS(op); \
+    }
+
+/* resultado de una comparacion entre enteros */
+static inline bool lat_comparar_enteros(lat_ins op, long x, long y)
+{
+    switch (op)
+    {
+    case COMPARE_OP_LT:
+        return x < y;
+    case COMPARE_OP_LTE:
+        return x <= y;
+    case COMPARE_OP_GT:
+        return x > y;
+    case COMPARE_OP_GTE:
+        return x >= y;
+    case COMPARE_OP_EQ:
+        return x == y;
+    default:
+        return x != y;
+    }
+}
+
+/* lectura de una variable usando el cache en linea de la instruccion: se
+ * busca en el contexto local, despues en los de las funciones que lo
+ * encierran y al final en el global. El cache solo guarda la posicion en el
+ * contexto local o en el global si no hay contextos intermedios, porque no
+ * tiene sus versiones. Un nombre indefinido se reporta y se lee como nulo */
+static inline lat_objeto* lat_cargar_nombre(lat_mv *mv, lat_objeto* contexto, lat_objeto* global, lat_cache_nombre* cache, lat_objeto* nombre)
+{
+    lat_objeto* padre = lat_instancia_padre(contexto);
+    bool encadenado = padre != NULL && padre != global;
+    int posicion;
+    bool es_global;
+    if (cache->version == lat_instancia_version(contexto) && cache->version_global == lat_instancia_version(global)
+            && (!cache->global || !encadenado))
+    {
+        return lat_instancia_valor(cache->global ? global : contexto, cache->posicion);
+    }
+    posicion = lat_instancia_buscar(contexto, nombre);
+    es_global = posicion < 0;
+    if (es_global)
+    {
+        lat_objeto* alcance;
+        for (alcance = padre; alcance != NULL && alcance != global; alcance = lat_instancia_padre(alcance))
+        {
+            posicion = lat_instancia_buscar(alcance, nombre);
+            if (posicion >= 0)
+            {
+                return lat_instancia_valor(alcance, posicion);
+            }
+        }
+        posicion = lat_instancia_buscar(global, nombre);
+    }
+    if (posicion < 0)
+    {
+        lat_registrar_error("Variable \"%s\" indefinida", lat_obtener_cadena(nombre));
+        return mv->objeto_nulo;
+    }
+    if (es_global && encadenado)
+    {
+        return lat_instancia_valor(global, posicion);
+    }
+    cache->global = es_global;
+    cache->version = lat_instancia_version(contexto);
+    cache->version_global = lat_instancia_version(global);
+    cache->posicion = posicion;
+    return lat_instancia_valor(es_global ? global : contexto, posicion);
+}
+
+/* asignacion de una variable usando el cache en linea de la instruccion;
+ * siempre se asigna en el contexto local */
+static inline void lat_guardar_nombre(lat_mv *mv, lat_objeto* contexto, lat_objeto* global, lat_cache_nombre* cache, lat_objeto* nombre, lat_objeto* valor)
+{
+    if (cache->version == lat_instancia_version(contexto) && cache->version_global == lat_instancia_version(global)
+            && (!cache->global || contexto == global))
+    {
+        lat_instancia_valor(contexto, cache->posicion) = valor;
+        return;
+    }
+    cache->posicion = lat_instancia_asignar(mv, contexto, nombre, valor);
+    cache->global = contexto == global;
+    cache->version = lat_instancia_version(contexto);
+    cache->version_global = lat_instancia_version(global);
+}
+
+/* lectura de una variable global: el nombre nunca es local, el cache solo
+ * depende de la version del contexto global. Un nombre indefinido se lee
+ * como nulo */
+static inline lat_objeto* lat_cargar_global(lat_mv *mv, lat_objeto* global, lat_cache_nombre* cache, lat_objeto* nombre)
+{
+    if (cache->version_global != lat_instancia_version(global))
+    {
+        int posicion = lat_instancia_buscar(global, nombre);
+        if (posicion < 0)
+        {
+            lat_registrar_error("Variable \"%s\" indefinida", lat_obtener_cadena(nombre));
+            return mv->objeto_nulo;
+        }
+        cache->version_global = lat_instancia_version(global);
+        cache->posicion = posicion;
+    }
+    return lat_instancia_valor(global, cache->posicion);
+}
+
+static inline void lat_guardar_global(lat_mv *mv, lat_objeto* global, lat_cache_nombre* cache, lat_objeto* nombre, lat_objeto* valor)
+{
+    if (cache->version_global == lat_instancia_version(global))
+    {
+        lat_instancia_valor(global, cache->posicion) = valor;
+        return;
+    }
+    cache->posicion = lat_instancia_asignar(mv, global, nombre, valor);
+    cache->version_global = lat_instancia_version(global);
+}
+
+/* los num_args argumentos del tope de la pila pasan a ser los parametros de
+ * fun: se verifica la aridad y se completan con nulo o se descartan los que
+ * sobran; despues se apilan las variables locales en nulo. Regresa la
+ * posicion del primer parametro */
+static int lat_preparar_variables(lat_mv *mv, lat_funcion* fun, int num_args)
 {
-    if (func->tipo == T_FUNC)
+    int i;
+    if (num_args != fun->num_params)
     {
-        if(!mv->REPL)
+        lat_registrar_error("La funcion esperaba %d argumentos y recibio %d", fun->num_params, num_args);
+        for (; num_args < fun->num_params; num_args++)
         {
-            lat_apilar_contexto(mv);
+            lat_apilar(mv, mv->objeto_nulo);
         }
-        lat_asignar_contexto_objeto(lat_obtener_contexto(mv), lat_cadena_nueva(mv, "$"), func);
-        lat_bytecode* inslist = ((lat_funcion*)func->datos.funcion)->bcode;
-        lat_bytecode cur;
-        int pos;
-        for (pos = 0, cur = inslist[pos]; cur.ins != RETURN_VALUE; cur = inslist[++pos])
+        mv->tope_pila -= num_args - fun->num_params;
+    }
+    lat_reservar_pila(mv, fun->num_locales);
+    for (i = 0; i < fun->num_locales; i++)
+    {
+        mv->pila[mv->tope_pila++] = mv->objeto_nulo;
+    }
+    return mv->tope_pila - fun->num_params - fun->num_locales;
+}
+
+/* contexto donde se definio la funcion; el programa principal no tiene y
+ * se ejecuta en el contexto actual */
+static inline lat_objeto* lat_alcance_funcion(lat_mv *mv, lat_objeto* func)
+{
+    return func->datos.alcance != NULL ? func->datos.alcance : lat_obtener_contexto(mv);
+}
+
+/* apila el marco de una llamada a una funcion de usuario; los argumentos ya
+ * estan en la pila y quedan como los parametros del marco. Con
+ * contexto_propio se apila un contexto local para los STORE_NAME cuyo padre
+ * es el alcance de la funcion; sin el, el marco usa el alcance directamente */
+static void lat_entrar_marco(lat_mv *mv, lat_objeto* func, lat_bytecode* retorno, int num_args, bool contexto_propio)
+{
+    lat_marco* m;
+    lat_funcion* fun = (lat_funcion*)func->datos.funcion;
+    lat_objeto* alcance = lat_alcance_funcion(mv, func);
+    int base = lat_preparar_variables(mv, fun, num_args);
+    if (mv->num_marcos == mv->tamanio_marcos)
+    {
+        mv->tamanio_marcos *= 2;
+        mv->marcos = (lat_marco*)lat_reasignar_memoria(mv->marcos, sizeof(lat_marco) * mv->tamanio_marcos);
+    }
+    if (contexto_propio)
+    {
+        lat_apilar_contexto(mv);
+        lat_instancia_padre(lat_obtener_contexto(mv)) = alcance;
+        alcance = lat_obtener_contexto(mv);
+    }
+    m = &mv->marcos[mv->num_marcos++];
+    m->fun = fun;
+    m->retorno = retorno;
+    m->base = base;
+    m->contexto = alcance;
+    m->contexto_propio = contexto_propio;
+    m->guarda_registros = false;
+    lat_reservar_pila(mv, fun->max_pila);
+}
+
+/* carga en variables locales los datos del marco que esta en el tope */
+#define CARGAR_MARCO() \
+    { \
+        lat_marco* m = &mv->marcos[mv->num_marcos - 1]; \
+        fun = m->fun; \
+        inslist = fun->bcode; \
+        constantes = fun->constantes; \
+        contexto = m->contexto; \
+        base = m->base; \
+    }
+
+/* al entrar y al regresar de una funcion todo valor en uso esta en la pila,
+ * los registros, los contextos o las constantes de los marcos */
+#define PUNTO_SEGURO() \
+    { \
+        if (mv->memoria_usada >= mv->umbral_recoleccion) \
+        { \
+            lat_recolectar_basura(mv); \
+        } \
+    }
+
+/* llamada desde CALL_FUNCTION y CALL_NAME_1, pc ya apunta a la instruccion de
+ * retorno: una funcion de usuario apila su marco y continua en este ciclo */
+#define LLAMAR(f, num_args) \
+    { \
+        lat_objeto* llamada = (f); \
+        if (lat_tipo(llamada) == T_FUNC) \
+        { \
+            lat_entrar_marco(mv, llamada, pc, (num_args), ((lat_funcion*)llamada->datos.funcion)->contexto_local); \
+            if (fun->usa_registros) \
+            { \
+                memcpy(mv->marcos[mv->num_marcos - 1].registros, mv->registros, sizeof(mv->registros)); \
+                mv->marcos[mv->num_marcos - 1].guarda_registros = true; \
+            } \
+            CARGAR_MARCO(); \
+            pc = inslist; \
+            PUNTO_SEGURO(); \
+        } \
+        else \
+        { \
+            lat_llamar_funcion(mv, llamada); \
+            lat_reservar_pila(mv, fun->max_pila); \
+        } \
+        DESPACHAR(); \
+    }
+
+lat_objeto* lat_llamar_funcion(lat_mv *mv, lat_objeto* func)
+{
+    if (lat_tipo(func) == T_FUNC)
+    {
+        /* el ciclo termina al regresar del marco con el que se entro */
+        int marco_inicial = mv->num_marcos;
+        lat_funcion* fun;
+        lat_bytecode* inslist;
+        lat_objeto** constantes;
+        lat_objeto* contexto;
+        lat_objeto* global = mv->contexto_pila[0];
+        int base;
+        lat_bytecode* pc;
+        /* el programa principal (y cada linea del REPL) se ejecuta en el
+         * contexto actual, las funciones que llama tienen su contexto local */
+        lat_entrar_marco(mv, func, NULL, 0, false);
+        CARGAR_MARCO();
+        pc = inslist;
+#ifdef LAT_DESPACHO_COMPUTADO
+        static void* tabla_despacho[] =
+        {
+            [NOP] = &&et_NOP,
+            [LOAD_CONST] = &&et_LOAD_CONST,
+            [STORE_NAME] = &&et_STORE_NAME,
+            [LOAD_NAME] = &&et_LOAD_NAME,
+            [LOAD_FAST] = &&et_LOAD_FAST,
+            [STORE_FAST] = &&et_STORE_FAST,
+            [LOAD_GLOBAL] = &&et_LOAD_GLOBAL,
+            [STORE_GLOBAL] = &&et_STORE_GLOBAL,
+            [CALL_FUNCTION] = &&et_CALL_FUNCTION,
+            [MAKE_FUNCTION] = &&et_MAKE_FUNCTION,
+            [RETURN_VALUE] = &&et_RETURN_VALUE,
+            [BINARY_ADD] = &&et_BINARY_ADD,
+            [BINARY_SUBTRACT] = &&et_BINARY_SUBTRACT,
+            [BINARY_MULTIPLY] = &&et_BINARY_MULTIPLY,
+            [BINARY_FLOOR_DIVIDE] = &&et_BINARY_FLOOR_DIVIDE,
+            [BINARY_MODULO] = &&et_BINARY_MODULO,
+            [COMPARE_OP_LT] = &&et_COMPARE_OP_LT,
+            [COMPARE_OP_LTE] = &&et_COMPARE_OP_LTE,
+            [COMPARE_OP_GT] = &&et_COMPARE_OP_GT,
+            [COMPARE_OP_GTE] = &&et_COMPARE_OP_GTE,
+            [COMPARE_OP_EQ] = &&et_COMPARE_OP_EQ,
+            [COMPARE_OP_NEQ] = &&et_COMPARE_OP_NEQ,
+            [POP_JUMP_IF_FALSE] = &&et_POP_JUMP_IF_FALSE,
+            [POP_JUMP_IF_TRUE] = &&et_POP_JUMP_IF_TRUE,
+            [JUMP_FORWARD] = &&et_JUMP_FORWARD,
+            [TAIL_CALL] = &&et_TAIL_CALL,
+            [CALL_BUILTIN] = &&et_CALL_BUILTIN,
+            [BUILD_MAP] = &&et_BUILD_MAP,
+            [BINARY_SUBSCR] = &&et_BINARY_SUBSCR,
+            [STORE_SUBSCR] = &&et_STORE_SUBSCR,
+            [COMPARE_CONST_JUMP_IF_FALSE] = &&et_COMPARE_CONST_JUMP_IF_FALSE,
+            [CALL_NAME_1] = &&et_CALL_NAME_1,
+            [LOAD_CONST_R] = &&et_LOAD_CONST_R,
+            [LOAD_NAME_R] = &&et_LOAD_NAME_R,
+            [LOAD_FAST_R] = &&et_LOAD_FAST_R,
+            [LOAD_GLOBAL_R] = &&et_LOAD_GLOBAL_R,
+            [PUSH_R] = &&et_PUSH_R,
+            [POP_R] = &&et_POP_R,
+            [BINARY_ADD_R] = &&et_BINARY_ADD_R,
+            [BINARY_SUBTRACT_R] = &&et_BINARY_SUBTRACT_R,
+            [BINARY_MULTIPLY_R] = &&et_BINARY_MULTIPLY_R,
+            [BINARY_FLOOR_DIVIDE_R] = &&et_BINARY_FLOOR_DIVIDE_R,
+            [BINARY_MODULO_R] = &&et_BINARY_MODULO_R,
+            [COMPARE_OP_LT_R] = &&et_COMPARE_OP_LT_R,
+            [COMPARE_OP_LTE_R] = &&et_COMPARE_OP_LTE_R,
+            [COMPARE_OP_GT_R] = &&et_COMPARE_OP_GT_R,
+            [COMPARE_OP_GTE_R] = &&et_COMPARE_OP_GTE_R,
+            [COMPARE_OP_EQ_R] = &&et_COMPARE_OP_EQ_R,
+            [COMPARE_OP_NEQ_R] = &&et_COMPARE_OP_NEQ_R
+        };
+#endif
+        for (;;)
         {
-            //printf("%i\t", pos);
-            switch ((int)cur.ins)
+            switch (LAT_INS(*pc))
             {
             /* redefinicion de instrucciones estilo Python*/
-            case LOAD_CONST:
-            {
-                //lat_imprimir_lista(mv, mv->pila);
-                lat_objeto *variable = (lat_objeto*)cur.a;
-                lat_apilar(mv, variable);
-                /*if(variable->tipo == T_STR){
-                    printf("LOAD_CONST %s\n", variable->datos.cadena);
+            INSTRUCCION(LOAD_CONST):
+                APILAR(constantes[LAT_ARG(*pc)]);
+                SIGUIENTE();
+            INSTRUCCION(STORE_NAME):
+                {
+                    lat_objeto *valor = DESAPILAR();
+                    lat_guardar_nombre(mv, contexto, global, &fun->caches[pc - inslist], constantes[LAT_ARG(*pc)], valor);
                 }
-                else{
-                    printf("LOAD_CONST %ld\n", variable->datos.entero);
-                }*/
-            }
-                break;
-            case STORE_NAME:{
-                    //lat_imprimir_lista(mv, mv->pila);
-                    lat_objeto *contexto = lat_obtener_contexto(mv);
-                    lat_objeto *variable = (lat_objeto*)cur.a;
-                    lat_objeto *valor = lat_desapilar(mv);
-                    lat_asignar_contexto_objeto(contexto, variable, valor);
-                    //printf("STORE_NAME %s\n", variable->datos.cadena);
+                SIGUIENTE();
+            INSTRUCCION(LOAD_NAME):
+                APILAR(lat_cargar_nombre(mv, contexto, global, &fun->caches[pc - inslist], constantes[LAT_ARG(*pc)]));
+                SIGUIENTE();
+            INSTRUCCION(LOAD_FAST):
+                APILAR(mv->pila[base + LAT_ARG(*pc)]);
+                SIGUIENTE();
+            INSTRUCCION(STORE_FAST):
+                {
+                    lat_objeto *valor = DESAPILAR();
+                    mv->pila[base + LAT_ARG(*pc)] = valor;
+                }
+                SIGUIENTE();
+            INSTRUCCION(LOAD_GLOBAL):
+                APILAR(lat_cargar_global(mv, global, &fun->caches[pc - inslist], constantes[LAT_ARG(*pc)]));
+                SIGUIENTE();
+            INSTRUCCION(STORE_GLOBAL):
+                {
+                    lat_objeto *valor = DESAPILAR();
+                    lat_guardar_global(mv, global, &fun->caches[pc - inslist], constantes[LAT_ARG(*pc)], valor);
                 }
-                break;
-            case LOAD_NAME: {
-                    //lat_imprimir_lista(mv, mv->pila);
-                    lat_objeto *contexto = lat_obtener_contexto(mv);
-                    lat_objeto *variable = (lat_objeto*)cur.a;
-                    lat_objeto *valor = lat_obtener_contexto_objeto(contexto, variable);
-                    lat_apilar(mv, valor);
-                    //printf("LOAD_NAME %s\n", variable->datos.cadena);
+                SIGUIENTE();
+            INSTRUCCION(BINARY_ADD):
+                ARITMETICA_ENTERA(BINARY_ADD, true, x + y);
+            INSTRUCCION(BINARY_SUBTRACT):
+                ARITMETICA_ENTERA(BINARY_SUBTRACT, true, x - y);
+            INSTRUCCION(BINARY_MULTIPLY):
+                ARITMETICA_ENTERA(BINARY_MULTIPLY, lat_multiplicar_enteros(x, y, &x), x);
+            INSTRUCCION(BINARY_FLOOR_DIVIDE):
+                ARITMETICA_ENTERA(BINARY_FLOOR_DIVIDE, y != 0, lat_division_entera(x, y));
+            INSTRUCCION(BINARY_MODULO):
+                ARITMETICA_ENTERA(BINARY_MODULO, y != 0, lat_modulo_entero(x, y));
+            INSTRUCCION(COMPARE_OP_LT):
+                COMPARACION_ENTERA(COMPARE_OP_LT, <);
+            INSTRUCCION(COMPARE_OP_LTE):
+                COMPARACION_ENTERA(COMPARE_OP_LTE, <=);
+            INSTRUCCION(COMPARE_OP_GT):
+                COMPARACION_ENTERA(COMPARE_OP_GT, >);
+            INSTRUCCION(COMPARE_OP_GTE):
+                COMPARACION_ENTERA(COMPARE_OP_GTE, >=);
+            INSTRUCCION(COMPARE_OP_EQ):
+                COMPARACION_ENTERA(COMPARE_OP_EQ, ==);
+            INSTRUCCION(COMPARE_OP_NEQ):
+                COMPARACION_ENTERA(COMPARE_OP_NEQ, !=);
+            INSTRUCCION(NOP):
+                SIGUIENTE();
+            INSTRUCCION(JUMP_FORWARD):
+                SALTAR(LAT_ARG(*pc));
+            INSTRUCCION(POP_JUMP_IF_FALSE):
+                if (lat_obtener_logico(DESAPILAR()) == false)
+                {
+                    SALTAR(LAT_ARG(*pc));
                 }
-                break;
-            case COMPARE_OP_EQ:
-                //printf("COMPARE_OP_EQ\n");
-                lat_igualdad(mv);
-                break;
-            case NOP:
-                //printf("NOP\n");
-                break;
-            case JUMP_FORWARD:
-                pos = ((int)cur.a - 1);
-                //printf("JUMP_FORWARD %i\n", (int)cur.a);
-                break;
-            case POP_JUMP_IF_FALSE:
+                SIGUIENTE();
+            INSTRUCCION(POP_JUMP_IF_TRUE):
+                if (lat_obtener_logico(DESAPILAR()) == true)
                 {
-                    //printf("POP_JUMP_IF_FALSE\n");
-                    //lat_imprimir_lista(mv, mv->pila);
-                    lat_objeto* cond = lat_desapilar(mv);
-                    if(lat_obtener_logico(cond) == false){
-                        pos = ((int)cur.a - 1);
-                    }
-                    //printf("POP_JUMP_IF_FALSE\t%i\n", (int)cur.a);
+                    SALTAR(LAT_ARG(*pc));
                 }
-                break;
-            case POP_JUMP_IF_TRUE:
+                SIGUIENTE();
+            INSTRUCCION(MAKE_FUNCTION):
                 {
-                    //lat_imprimir_lista(mv, mv->pila);
-                    lat_objeto* cond = lat_desapilar(mv);
-                    if(lat_obtener_logico(cond) == true){
-                        pos = ((int)cur.a - 1);
+                    /* la funcion ve las variables del contexto donde se define */
+                    lat_objeto* funcion = lat_definir_funcion(mv, (lat_funcion*)constantes[LAT_ARG(*pc)]->datos.funcion);
+                    funcion->datos.alcance = contexto;
+                    contexto->datos.atributos->capturado = true;
+                    APILAR(funcion);
+                    SIGUIENTE();
+                }
+            INSTRUCCION(CALL_FUNCTION):
+                {
+                    lat_objeto* funcion = DESAPILAR();
+                    int num_args = LAT_ARG(*pc);
+                    pc++;
+                    LLAMAR(funcion, num_args);
+                }
+            INSTRUCCION(TAIL_CALL):
+                {
+                    /* retorno f(...): la funcion llamada ocupa el marco y el
+                     * contexto de la actual; le sigue un RETURN_VALUE que solo
+                     * se ejecuta si no se pudo reutilizar el marco (el marco no
+                     * tiene el contexto local que necesita la funcion) */
+                    lat_marco* m = &mv->marcos[mv->num_marcos - 1];
+                    lat_objeto* funcion = DESAPILAR();
+                    int num_args = LAT_ARG(*pc);
+                    if (lat_tipo(funcion) == T_FUNC && (m->contexto_propio || !((lat_funcion*)funcion->datos.funcion)->contexto_local)
+                            && !(m->contexto_propio && m->contexto->datos.atributos->capturado))
+                    {
+                        memmove(&mv->pila[m->base], &mv->pila[mv->tope_pila - num_args], sizeof(lat_objeto*) * num_args);
+                        mv->tope_pila = m->base + num_args;
+                        m->fun = (lat_funcion*)funcion->datos.funcion;
+                        lat_preparar_variables(mv, m->fun, num_args);
+                        if (m->contexto_propio)
+                        {
+                            lat_instancia_limpiar(mv, m->contexto);
+                            lat_instancia_padre(m->contexto) = lat_alcance_funcion(mv, funcion);
+                        }
+                        else
+                        {
+                            m->contexto = lat_alcance_funcion(mv, funcion);
+                        }
+                        CARGAR_MARCO();
+                        lat_reservar_pila(mv, fun->max_pila);
+                        pc = inslist;
+                        PUNTO_SEGURO();
+                        DESPACHAR();
                     }
-                    //printf("POP_JUMP_IF_TRUE\t%i\n", (int)cur.a);
+                    pc++;
+                    LLAMAR(funcion, num_args);
                 }
-                break;
-            case MAKE_FUNCTION: {
-                    //lat_imprimir_lista(mv, mv->pila);
-                    lat_objeto* funcion_usuario = lat_definir_funcion(mv, (lat_bytecode*)cur.a, (int)cur.b);
-                    lat_apilar(mv, funcion_usuario);
-                    //printf("MAKE_FUNCTION\n");
+            INSTRUCCION(CALL_BUILTIN):
+                {
+                    /* la funcion se llama directamente mientras la variable
+                     * global siga siendo la funcion predefinida */
+                    int nativa = LAT_A(*pc);
+                    lat_objeto* funcion = lat_cargar_global(mv, global, &fun->caches[pc - inslist], mv->nombres_nativas[nativa]);
+                    pc++;
+                    if (lat_tipo(funcion) == T_CFUNC && funcion->datos.cfunc == lat_nativas[nativa].funcion)
+                    {
+                        lat_nativas[nativa].funcion(mv);
+                        lat_reservar_pila(mv, fun->max_pila);
+                        DESPACHAR();
+                    }
+                    LLAMAR(funcion, LAT_B(pc[-1]));
                 }
-                break;
-            case CALL_FUNCTION:
+            INSTRUCCION(BUILD_MAP):
                 {
-                    //lat_imprimir_lista(mv, mv->pila);
-                    lat_objeto* funcion = lat_desapilar(mv);
-                    lat_objeto* resultado = NULL;
-                    if(funcion->tipo == T_FUNC){
-                        resultado = lat_llamar_funcion(mv, funcion);
-                        if(resultado == NULL) {
-                            resultado = lat_desapilar(mv);
+                    /* los pares estan en el orden en que se escribieron */
+                    int n = LAT_ARG(*pc);
+                    lat_objeto* dic = lat_diccionario_nuevo(mv);
+                    lat_objeto** par = &mv->pila[mv->tope_pila - 2 * n];
+                    int k;
+                    for (k = 0; k < n; k++, par += 2)
+                    {
+                        if (lat_diccionario_llave_valida(par[0]))
+                        {
+                            lat_diccionario_asignar(mv, dic->datos.diccionario, par[0], par[1]);
+                        }
+                        else
+                        {
+                            lat_registrar_error("Tipo de llave no soportado %d", lat_tipo(par[0]));
                         }
-                    }else{
-                        lat_llamar_funcion(mv, funcion);
                     }
-                    //printf("CALL_FUNCTION\n");
+                    mv->tope_pila -= 2 * n;
+                    APILAR(dic);
                 }
-                break;
-            case RETURN_VALUE:
+                SIGUIENTE();
+            INSTRUCCION(BINARY_SUBSCR):
                 {
-                    //printf("RETURN_VALUE\t");
-                    return NULL;
+                    lat_objeto* llave = DESAPILAR();
+                    lat_objeto* dic = DESAPILAR();
+                    lat_objeto* valor = NULL;
+                    if (lat_tipo(dic) != T_DICT)
+                    {
+                        lat_registrar_error("El objeto no es un diccionario");
+                    }
+                    else if (!lat_diccionario_llave_valida(llave))
+                    {
+                        lat_registrar_error("Tipo de llave no soportado %d", lat_tipo(llave));
+                    }
+                    else if ((valor = lat_diccionario_obtener(dic->datos.diccionario, llave)) == NULL)
+                    {
+                        lat_registrar_error("Llave no encontrada en el diccionario");
+                    }
+                    APILAR(valor == NULL ? mv->objeto_nulo : valor);
                 }
-                break;
-
+                SIGUIENTE();
+            INSTRUCCION(STORE_SUBSCR):
+                {
+                    lat_objeto* llave = DESAPILAR();
+                    lat_objeto* dic = DESAPILAR();
+                    lat_objeto* valor = DESAPILAR();
+                    if (lat_tipo(dic) != T_DICT)
+                    {
+                        lat_registrar_error("El objeto no es un diccionario");
+                    }
+                    else if (!lat_diccionario_llave_valida(llave))
+                    {
+                        lat_registrar_error("Tipo de llave no soportado %d", lat_tipo(llave));
+                    }
+                    else
+                    {
+                        lat_diccionario_asignar(mv, dic->datos.diccionario, llave, valor);
+                    }
+                }
+                SIGUIENTE();
+            INSTRUCCION(COMPARE_CONST_JUMP_IF_FALSE):
+                {
+                    /* pc[0]: LOAD_NAME, pc[1]: LOAD_CONST, pc[2]: COMPARE_OP_*, pc[3]: POP_JUMP_IF_FALSE;
+                     * un nombre de LOAD_GLOBAL nunca esta en el contexto local,
+                     * asi que lat_cargar_nombre sirve para ambos casos */
+                    lat_objeto* a = lat_cargar_nombre(mv, contexto, global, &fun->caches[pc - inslist], constantes[LAT_ARG(pc[0])]);
+                    lat_objeto* b = constantes[LAT_ARG(pc[1])];
+                    bool cond;
+                    if (lat_ambos_etiquetados(a, b))
+                    {
+                        cond = lat_comparar_enteros(LAT_INS(pc[2]), lat_valor_etiquetado(a), lat_valor_etiquetado(b));
+                    }
+                    else
+                    {
+                        APILAR(a);
+                        APILAR(b);
+                        lat_operador_binario(mv, LAT_INS(pc[2]));
+                        cond = lat_obtener_logico(DESAPILAR());
+                    }
+                    if (cond == false)
+                    {
+                        SALTAR(LAT_ARG(pc[3]));
+                    }
+                    pc += 4;
+                    DESPACHAR();
+                }
+            INSTRUCCION(CALL_NAME_1):
+                {
+                    /* pc[0]: LOAD_CONST, pc[1]: LOAD_NAME o LOAD_GLOBAL, pc[2]: CALL_FUNCTION 1 */
+                    lat_objeto* funcion = lat_cargar_nombre(mv, contexto, global, &fun->caches[pc + 1 - inslist], constantes[LAT_ARG(pc[1])]);
+                    APILAR(constantes[LAT_ARG(pc[0])]);
+                    pc += 3;
+                    LLAMAR(funcion, 1);
+                }
+            INSTRUCCION(LOAD_CONST_R):
+                mv->registros[LAT_A(*pc)] = constantes[LAT_BX(*pc)];
+                SIGUIENTE();
+            INSTRUCCION(LOAD_NAME_R):
+                mv->registros[LAT_A(*pc)] = lat_cargar_nombre(mv, contexto, global, &fun->caches[pc - inslist], constantes[LAT_BX(*pc)]);
+                SIGUIENTE();
+            INSTRUCCION(LOAD_FAST_R):
+                mv->registros[LAT_A(*pc)] = mv->pila[base + LAT_BX(*pc)];
+                SIGUIENTE();
+            INSTRUCCION(LOAD_GLOBAL_R):
+                mv->registros[LAT_A(*pc)] = lat_cargar_global(mv, global, &fun->caches[pc - inslist], constantes[LAT_BX(*pc)]);
+                SIGUIENTE();
+            INSTRUCCION(PUSH_R):
+                APILAR(mv->registros[LAT_A(*pc)]);
+                SIGUIENTE();
+            INSTRUCCION(POP_R):
+                mv->registros[LAT_A(*pc)] = DESAPILAR();
+                SIGUIENTE();
+            INSTRUCCION(BINARY_ADD_R):
+                ARITMETICA_REGISTROS(BINARY_ADD, true, x + y);
+            INSTRUCCION(BINARY_SUBTRACT_R):
+                ARITMETICA_REGISTROS(BINARY_SUBTRACT, true, x - y);
+            INSTRUCCION(BINARY_MULTIPLY_R):
+                ARITMETICA_REGISTROS(BINARY_MULTIPLY, lat_multiplicar_enteros(x, y, &x), x);
+            INSTRUCCION(BINARY_FLOOR_DIVIDE_R):
+                ARITMETICA_REGISTROS(BINARY_FLOOR_DIVIDE, y != 0, lat_division_entera(x, y));
+            INSTRUCCION(BINARY_MODULO_R):
+                ARITMETICA_REGISTROS(BINARY_MODULO, y != 0, lat_modulo_entero(x, y));
+            INSTRUCCION(COMPARE_OP_LT_R):
+                COMPARACION_REGISTROS(COMPARE_OP_LT, <);
+            INSTRUCCION(COMPARE_OP_LTE_R):
+                COMPARACION_REGISTROS(COMPARE_OP_LTE, <=);
+            INSTRUCCION(COMPARE_OP_GT_R):
+                COMPARACION_REGISTROS(COMPARE_OP_GT, >);
+            INSTRUCCION(COMPARE_OP_GTE_R):
+                COMPARACION_REGISTROS(COMPARE_OP_GTE, >=);
+            INSTRUCCION(COMPARE_OP_EQ_R):
+                COMPARACION_REGISTROS(COMPARE_OP_EQ, ==);
+            INSTRUCCION(COMPARE_OP_NEQ_R):
+                COMPARACION_REGISTROS(COMPARE_OP_NEQ, !=);
+            INSTRUCCION(RETURN_VALUE):
+                {
+                    /* el resultado reemplaza a los argumentos y a lo que la
+                     * funcion haya dejado en la pila */
+                    lat_marco* m = &mv->marcos[mv->num_marcos - 1];
+                    lat_objeto* resultado = mv->tope_pila > m->base ? mv->pila[mv->tope_pila - 1] : mv->objeto_nulo;
+                    mv->tope_pila = m->base;
+                    pc = m->retorno;
+                    if (m->contexto_propio)
+                    {
+                        lat_desapilar_contexto(mv);
+                    }
+                    mv->num_marcos--;
+                    if (mv->num_marcos == marco_inicial)
+                    {
+                        return resultado;
+                    }
+                    APILAR(resultado);
+                    CARGAR_MARCO();
+                    if (fun->usa_registros)
+                    {
+                        memcpy(mv->registros, mv->marcos[mv->num_marcos].registros, sizeof(mv->registros));
+                    }
+                    lat_reservar_pila(mv, fun->max_pila);
+                    PUNTO_SEGURO();
+                    DESPACHAR();
+                }
+            default:
+                lat_registrar_error("Instruccion desconocida %d", (int)LAT_INS(*pc));
+                SIGUIENTE();
             }   //end switch
         }   //end for
-        if(!mv->REPL)
-        {
-            lat_desapilar_contexto(mv);
-        }
     }
-    else if (func->tipo == T_CFUNC)
+    else if (lat_tipo(func) == T_CFUNC)
     {
         ((void (*)(lat_mv*))(func->datos.funcion))(mv);
     }
     else
     {
-        debug("func->type: %d", func->tipo);
+        debug("func->type: %d", lat_tipo(func));
         lat_registrar_error("Object not a function");
     }
 
     return NULL;
 }
 
+void lat_recolectar_basura(lat_mv *mv)
+{
+    int i, k;
+    for (i = 0; i < mv->tope_pila; i++)
+    {
+        lat_marcar_objeto(mv, mv->pila[i]);
+    }
+    for (i = 0; i < LAT_NUM_REGISTROS; i++)
+    {
+        lat_marcar_objeto(mv, mv->registros[i]);
+    }
+    for (i = 0; i <= mv->apuntador_pila; i++)
+    {
+        lat_marcar_objeto(mv, mv->contexto_pila[i]);
+    }
+    for (i = 0; i < mv->num_marcos; i++)
+    {
+        lat_marco* m = &mv->marcos[i];
+        lat_marcar_objeto(mv, m->contexto);
+        for (k = 0; k < m->fun->num_constantes; k++)
+        {
+            lat_marcar_objeto(mv, m->fun->constantes[k]);
+        }
+        if (m->guarda_registros)
+        {
+            for (k = 0; k < LAT_NUM_REGISTROS; k++)
+            {
+                lat_marcar_objeto(mv, m->registros[k]);
+            }
+        }
+    }
+    lat_marcar_objeto(mv, mv->objeto_cierto);
+    lat_marcar_objeto(mv, mv->objeto_falso);
+    lat_marcar_objeto(mv, mv->objeto_nulo);
+    lat_marcar_grises(mv);
+    /* el barrido vuelve a sumar la memoria de los objetos que sobreviven */
+    mv->memoria_usada = 0;
+    lat_slab_barrer(&mv->objetos, lat_barrer_objeto, mv);
+    mv->umbral_recoleccion = mv->memoria_usada * 2 > UMBRAL_RECOLECCION ? mv->memoria_usada * 2 : UMBRAL_RECOLECCION;
+}
+
+/* saca el diccionario que recibe una funcion; NULL si el objeto no lo es */
+static lat_diccionario* lat_desapilar_diccionario(lat_mv *mv)
+{
+    lat_objeto* o = lat_desapilar(mv);
+    if (lat_tipo(o) != T_DICT)
+    {
+        lat_registrar_error("El objeto no es un diccionario");
+        return NULL;
+    }
+    return o->datos.diccionario;
+}
+
+/* saca la llave que recibe una funcion; NULL si no es cadena ni entero */
+static lat_objeto* lat_desapilar_llave(lat_mv *mv)
+{
+    lat_objeto* llave = lat_desapilar(mv);
+    if (!lat_diccionario_llave_valida(llave))
+    {
+        lat_registrar_error("Tipo de llave no soportado %d", lat_tipo(llave));
+        return NULL;
+    }
+    return llave;
+}
+
+void lat_longitud(lat_mv *mv)
+{
+    lat_diccionario* d = lat_desapilar_diccionario(mv);
+    lat_apilar(mv, d == NULL ? mv->objeto_nulo : lat_entero_nuevo(mv, (long)d->num_llaves));
+}
+
+void lat_contiene(lat_mv *mv)
+{
+    lat_objeto* llave = lat_desapilar_llave(mv);
+    lat_diccionario* d = lat_desapilar_diccionario(mv);
+    if (d == NULL || llave == NULL)
+    {
+        lat_apilar(mv, mv->objeto_nulo);
+        return;
+    }
+    lat_apilar(mv, lat_diccionario_obtener(d, llave) != NULL ? mv->objeto_cierto : mv->objeto_falso);
+}
+
+void lat_eliminar(lat_mv *mv)
+{
+    lat_objeto* llave = lat_desapilar_llave(mv);
+    lat_diccionario* d = lat_desapilar_diccionario(mv);
+    if (d == NULL || llave == NULL)
+    {
+        lat_apilar(mv, mv->objeto_nulo);
+        return;
+    }
+    lat_apilar(mv, lat_diccionario_eliminar(d, llave) ? mv->objeto_cierto : mv->objeto_falso);
+}
+
 void lat_salir(lat_mv *mv)
 {
     lat_apilar(mv, lat_entero_nuevo(mv, 0L));
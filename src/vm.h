@@ -33,12 +33,20 @@ THE SOFTWARE.
 /**\brief Objeto tipo maquina virtual */
 typedef struct lat_mv lat_mv;
 
+#include <stdint.h>
+
 #include "utils.h"
+#include "libmem.h"
 #include "object.h"
 
 /**\brief Bandera para debuguear las instrucciones de la maquina virtual */
 //#define DEPURAR_MV 0
 
+/**\brief Verifica los limites de la pila en cada instruccion. Sin esta bandera
+  * la MV reserva la profundidad maxima de la funcion al entrar y apila sin
+  * verificar */
+//#define LAT_VERIFICAR_PILA 1
+
 /**\brief Instrucciones de la maquina virtual */
 typedef enum lat_ins
 {
@@ -47,6 +55,10 @@ typedef enum lat_ins
     LOAD_CONST,
     STORE_NAME,
     LOAD_NAME,
+    LOAD_FAST,              /**< Apila la variable local (o parametro) numero arg del marco */
+    STORE_FAST,             /**< Asigna el tope de la pila a la variable local (o parametro) numero arg */
+    LOAD_GLOBAL,            /**< Apila la variable global con nombre arg */
+    STORE_GLOBAL,           /**< Asigna el tope de la pila a la variable global con nombre arg */
     CALL_FUNCTION,          /**< Llamada a una funcion */
     MAKE_FUNCTION,          /**< Define una funcion */
     RETURN_VALUE,           /**< Fin de la maquina virtual */
@@ -63,50 +75,199 @@ typedef enum lat_ins
     COMPARE_OP_NEQ,         /**< Operador != */
     POP_JUMP_IF_FALSE,
     POP_JUMP_IF_TRUE,
-    JUMP_FORWARD
+    JUMP_FORWARD,
+    TAIL_CALL,              /**< Llamada en posicion de retorno, reutiliza el marco actual */
+    CALL_BUILTIN,           /**< Llamada a la funcion predefinida A con B argumentos (si su nombre no se reasigno) */
+    BUILD_MAP,              /**< Crea un diccionario con los arg pares llave, valor del tope de la pila */
+    BINARY_SUBSCR,          /**< Apila diccionario[llave] */
+    STORE_SUBSCR,           /**< diccionario[llave] = valor */
+    /* superinstrucciones: ocupan el lugar de la secuencia que reemplazan y
+       leen sus argumentos de las instrucciones originales que la siguen */
+    COMPARE_CONST_JUMP_IF_FALSE,    /**< LOAD_NAME (o LOAD_GLOBAL), LOAD_CONST, COMPARE_OP_*, POP_JUMP_IF_FALSE */
+    CALL_NAME_1,                    /**< LOAD_CONST, LOAD_NAME (o LOAD_GLOBAL), CALL_FUNCTION 1 */
+    /* instrucciones de registros (modo -r): A es el registro destino, B y C
+       un registro o una constante (LAT_RK_CONSTANTE); los operadores siguen el
+       mismo orden que BINARY_ADD .. COMPARE_OP_NEQ */
+    LOAD_CONST_R,           /**< R[A] = constante Bx */
+    LOAD_NAME_R,            /**< R[A] = variable con nombre Bx */
+    LOAD_FAST_R,            /**< R[A] = variable local (o parametro) numero Bx */
+    LOAD_GLOBAL_R,          /**< R[A] = variable global con nombre Bx */
+    PUSH_R,                 /**< Apila R[A] */
+    POP_R,                  /**< R[A] = tope de la pila */
+    BINARY_ADD_R,           /**< R[A] = RK[B] + RK[C] */
+    BINARY_SUBTRACT_R,      /**< R[A] = RK[B] - RK[C] */
+    BINARY_MULTIPLY_R,      /**< R[A] = RK[B] * RK[C] */
+    BINARY_FLOOR_DIVIDE_R,  /**< R[A] = RK[B] / RK[C] */
+    BINARY_MODULO_R,        /**< R[A] = RK[B] % RK[C] */
+    COMPARE_OP_LT_R,        /**< R[A] = RK[B] < RK[C] */
+    COMPARE_OP_LTE_R,       /**< R[A] = RK[B] <= RK[C] */
+    COMPARE_OP_GT_R,        /**< R[A] = RK[B] > RK[C] */
+    COMPARE_OP_GTE_R,       /**< R[A] = RK[B] >= RK[C] */
+    COMPARE_OP_EQ_R,        /**< R[A] = RK[B] == RK[C] */
+    COMPARE_OP_NEQ_R        /**< R[A] = RK[B] != RK[C] */
 } lat_ins;
 
 
-/**\brief Estructura que almacena las instrucciones bytecode de la MV */
-typedef struct lat_bytecode
+/**\brief Instruccion bytecode de la MV
+  *
+  * Cada instruccion ocupa 32 bits: 8 bits para la operacion (lat_ins) y 24 bits
+  * para el argumento. Segun la instruccion el argumento es un indice en la
+  * tabla de constantes de la funcion (LOAD_CONST, LOAD_NAME, STORE_NAME,
+  * MAKE_FUNCTION), el numero de instruccion destino (saltos) o el numero de
+  * argumentos (CALL_FUNCTION).
+  */
+typedef uint32_t lat_bytecode;
+
+/**\brief Obtiene la operacion de una instruccion */
+#define LAT_INS(bc) ((lat_ins)((bc) & 0xFF))
+/**\brief Obtiene el argumento de 24 bits de una instruccion */
+#define LAT_ARG(bc) ((int)((bc) >> 8))
+/**\brief Valor maximo del argumento de una instruccion */
+#define LAT_ARG_MAX 0xFFFFFF
+
+/**\brief Numero de registros de la MV */
+#define LAT_NUM_REGISTROS 8
+/**\brief Bit que indica que el operando B o C es una constante y no un registro */
+#define LAT_RK_CONSTANTE 0x80
+/**\brief Argumento de una instruccion de registros con operandos A, B y C de 8 bits */
+#define LAT_ABC(a, b, c) ((a) | ((b) << 8) | ((c) << 16))
+/**\brief Argumento de una instruccion de registros con A de 8 bits y Bx de 16 bits */
+#define LAT_ABX(a, bx) ((a) | ((bx) << 8))
+/**\brief Obtiene el operando A (registro destino) */
+#define LAT_A(bc) ((int)(((bc) >> 8) & 0xFF))
+/**\brief Obtiene el operando B */
+#define LAT_B(bc) ((int)(((bc) >> 16) & 0xFF))
+/**\brief Obtiene el operando C */
+#define LAT_C(bc) ((int)((bc) >> 24))
+/**\brief Obtiene el operando Bx de 16 bits */
+#define LAT_BX(bc) ((int)((bc) >> 16))
+/**\brief Valor maximo del operando Bx */
+#define LAT_BX_MAX 0xFFFF
+
+/**\brief Cache en linea de una instruccion LOAD_NAME / STORE_NAME
+  * (o LOAD_GLOBAL / STORE_GLOBAL)
+  *
+  * Guarda la posicion del valor en la instancia donde se encontro el nombre
+  * junto con las versiones (formas) del contexto local y del global; mientras
+  * ninguna cambie la posicion sigue siendo valida y la variable se lee sin
+  * buscar el nombre. Los contextos locales con los mismos atributos comparten
+  * la forma, asi que el cache sirve en todas las llamadas de una funcion.
+  * LOAD_GLOBAL / STORE_GLOBAL solo usan la version global.
+  */
+typedef struct lat_cache_nombre
 {
-    lat_ins ins;    /**< Instruccion */
-    void* a;        /**< datos a */
-    void* b;        /**< datos b */
-    void* c;        /**< datos c */
-} lat_bytecode;
+    unsigned long version;  /**< Version del contexto local */
+    unsigned long version_global;   /**< Version del contexto global */
+    int posicion;           /**< Posicion del valor en el contexto donde esta la variable */
+    bool global;            /**< La variable esta en el contexto global */
+} lat_cache_nombre;
 
 /**\brief Define una funcion de usuario */
 typedef struct lat_funcion
 {
     int num_params;         /**< Numero de argumentos para la funcion */
+    int num_locales;        /**< Numero de variables locales, ocupan los lugares siguientes a los parametros */
     list_node* params;      /**< Parametros para la funcion */
     lat_bytecode* bcode;    /**< Instrucciones de la funcion */
+    int num_bcode;          /**< Numero de instrucciones */
+    lat_objeto** constantes;    /**< Constantes y nombres referenciados por las instrucciones */
+    int num_constantes;     /**< Numero de constantes */
+    int max_pila;           /**< Profundidad maxima de la pila que usa la funcion */
+    lat_cache_nombre* caches;   /**< Cache en linea por instruccion (indice = numero de instruccion) */
+    bool usa_registros;     /**< La funcion tiene instrucciones de registros */
+    bool contexto_local;    /**< La funcion asigna variables por nombre (STORE_NAME) y necesita un contexto local */
     //lat_objeto *closure;
 } lat_funcion;
 
+/**\brief Marco de llamada de una funcion de usuario
+  *
+  * Las llamadas entre funciones de usuario no usan la pila de C: la MV apila un
+  * marco y continua en el mismo ciclo de despacho con las instrucciones de la
+  * funcion llamada; al regresar desapila el marco y continua en la instruccion
+  * guardada en retorno. Los argumentos se quedan en la pila y son los
+  * parametros de la funcion; le siguen las variables locales (LOAD_FAST /
+  * STORE_FAST).
+  */
+typedef struct lat_marco
+{
+    lat_funcion* fun;       /**< Funcion en ejecucion */
+    lat_bytecode* retorno;  /**< Instruccion donde continua la funcion que llamo */
+    int base;               /**< Posicion en la pila del primer argumento; los parametros y las variables locales ocupan base .. base + num_params + num_locales - 1 */
+    lat_objeto* contexto;   /**< Contexto con las variables locales de la llamada (su padre es el contexto donde se definio la funcion) o ese contexto si la funcion no asigna por nombre */
+    bool contexto_propio;   /**< Indica si el marco apilo su contexto y debe desapilarlo al regresar */
+    lat_objeto* registros[LAT_NUM_REGISTROS];  /**< Registros de la funcion que llamo */
+    bool guarda_registros;  /**< registros tiene los de la funcion que llamo (la funcion usa registros) */
+} lat_marco;
+
 /**\brief Define la maquina virtual (MV) */
 struct lat_mv
 {
-    list_node* pila;     /**< pila de la maquina virtual */
+    lat_objeto** pila;     /**< pila de la maquina virtual */
+    int tope_pila;      /**< Numero de objetos en la pila */
+    int tamanio_pila;      /**< Capacidad reservada de la pila */
     list_node* modulos;     /**< modulos importados en la MV */
     list_node* todos_objetos;     /**< objetos creados dinamicamente en la MV */
     list_node* basurero_objetos;     /**< objetos listos para liberar por el colector de basura */
-    lat_objeto* registros[8];    /**< Registros auxiliares de la MV */
-    lat_objeto* contexto_pila[256];   /**< Tabla hash para el contexto actual */
+    lat_objeto* registros[LAT_NUM_REGISTROS];    /**< Registros de las instrucciones de registros */
+    lat_objeto** contexto_pila;   /**< Tabla hash para el contexto actual */
+    int tamanio_contexto;      /**< Capacidad reservada de la pila de contextos */
+    lat_marco* marcos;      /**< Pila de marcos de llamada */
+    int num_marcos;         /**< Numero de marcos activos */
+    int tamanio_marcos;     /**< Capacidad reservada de la pila de marcos */
     lat_objeto* objeto_cierto;   /**< Valor logico verdadero */
     lat_objeto* objeto_falso;   /**< Valor logico falso */
-    size_t memoria_usada;      /**< Tamanio de memoria creado dinamicamente */
+    lat_objeto* objeto_nulo;    /**< Valor nulo, resultado de una funcion sin retorno */
+    size_t memoria_usada;      /**< Memoria de los objetos creados desde la ultima recoleccion mas la que sobrevivio */
+    size_t umbral_recoleccion;  /**< Al llegar memoria_usada a este tamanio se recolecta basura en el siguiente punto seguro */
+    lat_objeto** grises;    /**< Objetos marcados cuyas referencias falta marcar */
+    int num_grises;         /**< Numero de objetos grises */
+    int tamanio_grises;     /**< Capacidad reservada de grises */
     int apuntador_pila;      /**< Apuntador de la pila */
     bool REPL;  /**< Indica si esta corriendo REPL */
+    bool modo_registros;    /**< El compilador genera instrucciones de registros para las expresiones */
+    lat_objeto** nombres_nativas;   /**< Nombre (cadena) de cada funcion predefinida, en el orden de la tabla */
+    lat_slab objetos;       /**< Celdas de tamanio fijo para los objetos de la MV */
+    struct lat_forma* forma_vacia;  /**< Forma de las instancias sin atributos; las formas y sus transiciones son de la MV */
 };
 
+/**\brief Recolector de basura (marcar y barrer)
+  *
+  * Marca lo alcanzable desde las raices (pila de operandos, registros,
+  * contextos, marcos de llamada con sus constantes y registros guardados,
+  * verdadero, falso y nulo) y devuelve al slab los objetos sin marcar. La MV
+  * solo recolecta en puntos seguros del ciclo de despacho (al entrar y al
+  * regresar de una funcion), donde todo valor en uso esta en alguna raiz.
+  *
+  * \param mv: Maquina virtual
+  */
+void lat_recolectar_basura(lat_mv *mv);
+
+/**\brief Busca una funcion predefinida (imprimir, escribir, ...)
+  *
+  * Las funciones predefinidas se registran en el contexto global; el
+  * compilador llama con CALL_BUILTIN a las que no son variables locales.
+  *
+  *\param nombre: Nombre de la funcion
+  *\return int: Indice en la tabla de funciones predefinidas o -1
+  */
+int lat_buscar_nativa(const char* nombre);
+
 /**\brief Crea la maquina virtual (MV)
   *
   *\return lat_mv: Apuntador a la MV
   */
 lat_mv* lat_crear_maquina_virtual();
 
+/**\brief Destruye la maquina virtual (MV)
+  *
+  * Libera los objetos que quedan en el slab con sus datos, las paginas del
+  * slab y las pilas de la MV. Las cadenas internadas son de todo el proceso y
+  * no se liberan.
+  *
+  *\param mv: Maquina virtual
+  */
+void lat_destruir_maquina_virtual(lat_mv *mv);
+
 /**\brief Inserta un objeto en la pila de la MV
   *
   *\param vm: Apuntador a la MV
@@ -121,6 +282,13 @@ void lat_apilar(lat_mv *mv, lat_objeto* o);
   */
 lat_objeto* lat_desapilar(lat_mv *mv);
 
+/**\brief Asegura espacio en la pila para n objetos mas
+  *
+  *\param vm: Apuntador a la MV
+  *\param n: Numero de objetos que se van a apilar
+  */
+void lat_reservar_pila(lat_mv *mv, int n);
+
 /**\brief Inserta un objeto al final de la lista
   *
   *\param lista: Apuntador a la lista
@@ -135,13 +303,17 @@ void lat_apilar_lista(lat_objeto* lista, lat_objeto* o);
   */
 lat_objeto* lat_desapilar_lista(lat_objeto* lista);
 
-/**\brief Inserta un contexto en la pila de la MV
+/**\brief Inserta un contexto local vacio en la pila de la MV
+  *
+  * El contexto solo guarda las variables que se asignan en la funcion; las
+  * demas se buscan en los contextos padre (las funciones que la encierran) y
+  * al final en el contexto global (contexto_pila[0]).
   *
   *\param vm: Apuntador a la MV
   */
 void lat_apilar_contexto(lat_mv *mv);
 
-/**\brief Extrae un contexto de la pila de la MV
+/**\brief Extrae un contexto local de la pila de la MV y libera su tabla
   *
   *\param vm: Apuntador a la MV
   */
@@ -168,13 +340,64 @@ lat_objeto* lat_desapilar_contexto_predefinido(lat_mv *mv);
   */
 lat_objeto* lat_obtener_contexto(lat_mv *mv);
 
+/**\brief Crea una funcion de usuario vacia para que el compilador agregue
+  * sus instrucciones y constantes
+  *
+  *\param num_params: Numero de parametros de la funcion
+  *\return lat_funcion: Apuntador a la funcion
+  */
+lat_funcion* lat_crear_funcion(int num_params);
+
+/**\brief Termina la generacion de una funcion: ajusta la memoria de las
+  * instrucciones a su tamanio real, calcula la profundidad de la pila y
+  * genera las superinstrucciones
+  *
+  *\param fun: Apuntador a la funcion
+  *\param num_bcode: Numero de instrucciones generadas
+  */
+void lat_terminar_funcion(lat_funcion* fun, int num_bcode);
+
+/**\brief Reemplaza las secuencias de instrucciones mas comunes por
+  * superinstrucciones
+  *
+  * La superinstruccion se escribe sobre la primera instruccion de la
+  * secuencia y el resto se deja intacto, por lo que los destinos de los
+  * saltos no cambian.
+  *
+  *\param fun: Apuntador a la funcion
+  */
+void lat_fusionar_instrucciones(lat_funcion* fun);
+
+/**\brief Agrega un objeto a la tabla de constantes de la funcion
+  *
+  * Las cadenas estan internadas, por lo que un mismo nombre ocupa una sola
+  * entrada en la tabla.
+  *
+  *\param fun: Apuntador a la funcion
+  *\param o: Objeto constante
+  *\return int: Indice de la constante o -1 si la tabla esta llena (se
+  * reporta el error y la constante no se agrega)
+  */
+int lat_agregar_constante(lat_funcion* fun, lat_objeto* o);
+
 /**\brief Define una funcion creada por el usuario
   *
   *\param vm: Apuntador a la MV
-  *\param inslist: Lista de instrucciones de la funcion
+  *\param fval: Funcion (instrucciones y constantes) ya generada
   *\return lat_objeto: Apuntador a un objeto tipo funcion
   */
-lat_objeto* lat_definir_funcion(lat_mv *mv, lat_bytecode* inslist, int num_params);
+lat_objeto* lat_definir_funcion(lat_mv *mv, lat_funcion* fval);
+
+/**\brief Calcula la profundidad maxima de la pila de una lista de instrucciones
+  *
+  * Solo existen saltos hacia adelante, por lo que la suma acumulada del efecto
+  * de cada instruccion es una cota superior de la profundidad real.
+  *
+  *\param inslist: Lista de instrucciones
+  *\param n: Numero de instrucciones
+  *\return int: Profundidad maxima de la pila
+  */
+int lat_calcular_max_pila(lat_bytecode* inslist, int n);
 
 /**\brief Define una funcion creada en C
   *
@@ -197,12 +420,14 @@ void lat_numero_lista(lat_mv *mv);
   */
 void lat_imprimir_lista(lat_mv *mv, list_node* l);
 
-/**\brief Envia a consola el contenido del diccionario
+struct lat_diccionario;
+
+/**\brief Envia a consola el contenido del diccionario (sin salto de linea)
   *
   *\param vm: Apuntador a la MV
   *\param d: Apuntador al diccionario
   */
-void lat_imprimir_diccionario(lat_mv *mv, hash_map* d);
+void lat_imprimir_diccionario(lat_mv *mv, struct lat_diccionario* d);
 
 /**\brief Envia a consola el valor del objeto
   *
@@ -222,6 +447,17 @@ void lat_clonar(lat_mv *mv);
   */
 void lat_igualdad(lat_mv *mv);
 
+/**\brief Operacion binaria generica
+  *
+  * Camino lento de las instrucciones BINARY_* y COMPARE_OP_* para tipos
+  * mixtos, decimales, cadenas y division entre cero. Saca los dos operandos
+  * de la pila y apila el resultado.
+  *
+  *\param vm: Apuntador a la MV
+  *\param ins: Instruccion BINARY_* o COMPARE_OP_*
+  */
+void lat_operador_binario(lat_mv *mv, lat_ins ins);
+
 /**\brief Convierte un valor a logico
   *
   *\param vm: Apuntador a la MV
@@ -240,6 +476,24 @@ void lat_entero(lat_mv *mv);
   */
 void lat_cadena(lat_mv *mv);
 
+/**\brief Numero de llaves de un diccionario
+  *
+  *\param vm: Apuntador a la MV
+  */
+void lat_longitud(lat_mv *mv);
+
+/**\brief Valida si un diccionario contiene una llave
+  *
+  *\param vm: Apuntador a la MV
+  */
+void lat_contiene(lat_mv *mv);
+
+/**\brief Elimina una llave de un diccionario
+  *
+  *\param vm: Apuntador a la MV
+  */
+void lat_eliminar(lat_mv *mv);
+
 /**\brief Sale del sistema de Latino REPL
   *
   *\param vm: Apuntador a la MV
@@ -249,17 +503,20 @@ void lat_salir(lat_mv *mv);
 /**\brief Crea un objeto bytecode
   *
   *\param i: Tipo de instruccion
-  *\param a: Registro a
-  *\param b: Registro b
-  *\param meta: Datos
+  *\param a: Argumento de 24 bits
   *\return lat_bytecode: Objeto bytecode
   */
-lat_bytecode lat_bc(lat_ins i, void* a, void* b, void* meta);
+lat_bytecode lat_bc(lat_ins i, int a);
 
 /**\brief Ejecuta una funcion
+  *
+  * Una funcion de usuario se ejecuta junto con todas las funciones de usuario
+  * que llame en un solo ciclo de despacho, usando la pila de marcos de la MV.
+  * Una funcion C deja su resultado en la pila.
   *
   *\param vm: Apuntador a la MV
   *\param func: Apuntador a funcion a ejecutar
+  *\return lat_objeto: Valor de retorno de la funcion de usuario (NULL para funciones C)
   */
 lat_objeto* lat_llamar_funcion(lat_mv *mv, lat_objeto* func);
 